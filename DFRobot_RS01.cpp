@@ -9,9 +9,108 @@
  * @url   https://github.com/DFRobot/DFRobot_RS01
  */
 #include "DFRobot_RS01.h"
+#include "DFRobot_RS01Stage.h"
+
+#if RS01_CRC_TABLE
+/* Modbus CRC16(polynomial 0xA001, reflected) of every byte value */
+static const uint16_t crc16Table[256] PROGMEM = {
+  0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+  0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+  0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+  0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+  0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+  0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+  0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+  0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+  0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+  0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+  0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+  0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+  0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+  0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+  0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+  0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+  0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+  0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+  0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+  0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+  0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+  0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+  0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+  0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+  0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+  0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+  0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+  0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+  0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+  0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+  0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+  0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+#endif
 
 DFRobot_RS01::DFRobot_RS01(uint8_t addr)
 {
+  _DFRobot_RTU = NULL;
+  _stream = NULL;
+  _timeoutMs = 500;
+  _waitMode = eWaitReady;
+  _adaptiveRead = false;
+  _sampleUs = 0;
+  _cacheValid = 0;
+  _cacheDirty = 0;
+  _hasBootSnapshot = false;
+  _snapshotRestored = false;
+  resetStats();
+  _retries = 0;
+  _retryJitterMs = RS01_RETRY_JITTER_MS;
+  _adaptiveTimeout = false;
+  _timeoutMultiple = RS01_ADAPTIVE_TIMEOUT_MULTIPLE;
+  _srttUs = 0;
+  _rttvarUs = 0;
+  _rttSamples = 0;
+  _rtoBackoff = 0;
+  _breakerFailures = 0;
+  _breakerProbeMs = RS01_BREAKER_PROBE_MS;
+  _failureRun = 0;
+  _circuitState = eCircuitClosed;
+  _circuitOpenMs = 0;
+  _baudrateCeiling = eBaudrate_1000000;
+#if defined(ESP32)
+  _taskHandle = NULL;
+  _taskRun = false;
+  _taskPeriodMs = 0;
+  _snapSeq = 0;
+#endif
+  memset(_targetProfile, 0, sizeof(_targetProfile));
+  _readTargets = 5;
+  memset(&measurement, 0, sizeof(measurement));
+  _asyncState = eAsyncIdle;
+  _asyncReady = false;
+  _asyncBlocking = false;
+  _asyncDoneUs = 0;
+  _zeroCopyRead = false;
+  _stage = NULL;
+  _transport = NULL;
+  _asyncTransaction.state = DFRobot_RS01Transport::eTransactionIdle;
+  _publishedValid = false;
+  _deadbandDistance = 0;
+  _deadbandIntensity = 0;
+  _pollMinMs = 0;
+  _pollMaxMs = 0;
+  _pollIntervalMs = 0;
+  _lastPollMs = 0;
+  _samplePeriodUs = 0;
+  _samplePolicy = eSampleDrop;
+  _sampleDeadlineUs = 0;
+  _sampleIssueUs = 0;
+  _sampleInFlight = false;
+  resetSampleStats();
+  _asyncError = 0;
+  _rxLen = 0;
+  _rxExpected = 0;
+  _measurementCallback = NULL;
+
   basicInfo.modbusAddr = addr;   // RS01modbus communication address
   measurementConfig.startPosition = 0x00C8;   // Default measurement start position 200
   measurementConfig.stopPosition = 0x1770;   // Default measurement stop position 6000
@@ -22,170 +121,1645 @@ DFRobot_RS01::DFRobot_RS01(uint8_t addr)
 }
 
 int DFRobot_RS01::begin(Stream *_serial)
+{
+  _rtu = DFRobot_RTU(_serial);   // Set up the embedded modbus-RTU object, calling begin() again allocates nothing
+  return begin(_serial, &_rtu);
+}
+
+int DFRobot_RS01::begin(Stream *_serial, DFRobot_RTU *rtu)
 {
   if(basicInfo.modbusAddr > 0xF7){
    DBG("Invaild Device addr.");
   }
 
-  _DFRobot_RTU = new DFRobot_RTU(_serial);   // Instantiate a modbus-RTU object for register reading and writing communication
-  delay(1000);   // wait for 1s
+  _stream = _serial;
+  _DFRobot_RTU = rtu;
+  _transport = NULL;
+  return startup();
+}
+
+int DFRobot_RS01::begin(DFRobot_RS01Transport *transport)
+{
+  if(basicInfo.modbusAddr > 0xF7){
+   DBG("Invaild Device addr.");
+  }
 
-  _DFRobot_RTU->setTimeoutTimeMs(500);   // Set the return message timeout to 500ms
-  delay(100);
+  _stream = NULL;
+  _DFRobot_RTU = NULL;
+  _transport = transport;
+  return startup();
+}
 
-  uint16_t pid=0;
-  if(0 != readData(RS01_PID_REG, &pid, 1))   // Judge whether the data bus is successful
-  {
-    DBG("ERR_DATA_BUS");
-    return ERR_DATA_BUS;
+DFRobot_RS01Transport *DFRobot_RS01::getTransport(void)
+{
+  return _transport;
+}
+
+int DFRobot_RS01::restart(void)
+{
+  return startup();
+}
+
+int DFRobot_RS01::startup(void)
+{
+  _asyncState = eAsyncIdle;   // A repeated begin() starts from a clean state
+
+  if(RS01_BROADCAST_ADDR == basicInfo.modbusAddr){
+    return NO_ERROR;   // Broadcast writes get no response, there's nothing to probe
+  }
+
+  uint8_t ret;
+  _snapshotRestored = false;
+  if(eWaitFixedDelay == _waitMode){
+    delay(1000);   // wait for 1s
+    setResponseTimeout(_timeoutMs);   // Set the return message timeout to 500ms
+    delay(100);
+
+    ret = readIdentity();
+  }else{
+    ret = waitReady(RS01_READY_TIMEOUT_MS);   // Replaces the fixed 1.1s power-up wait
   }
 
-  DBG("real sensor pid=");DBG(pid,HEX);
-  if(RS01_PID != pid)   // Judge whether the chip version matches
+  if(RS01_PID_MISMATCH == ret)   // Judge whether the chip version matches
   {
     DBG("ERR_IC_VERSION");
     return ERR_IC_VERSION;
   }
+  if(0 != ret)   // Judge whether the data bus is successful
+  {
+    DBG("ERR_DATA_BUS");
+    return ERR_DATA_BUS;
+  }
 
+  if(_hasBootSnapshot){
+    _snapshotRestored = restoreSnapshot();
+  }
   return NO_ERROR;
 }
 
+uint8_t DFRobot_RS01::readIdentity(void)
+{
+  uint16_t regs[6] = {0};
+  uint8_t count = _hasBootSnapshot ? 6 : 1;   // The rest of the basic information costs 10 bytes, not a round trip
+  uint8_t ret = readData(RS01_PID_REG, regs, count);
+  if(ret){
+    return ret;
+  }
+  if(RS01_PID != regs[0]){
+    DBG("real sensor pid=");DBG(regs[0],HEX);
+    return RS01_PID_MISMATCH;   // Not eRTU_ID_ERROR, the RTU layer reports a reply from another slave with it
+  }
+  if(6 == count){
+    memcpy(&basicInfo, regs, sizeof(regs));
+    _cacheValid |= RS01_BASIC_INFO_MASK;
+  }
+  return 0;
+}
+
+bool DFRobot_RS01::restoreSnapshot(void)
+{
+  if((RS01_SNAPSHOT_MAGIC != _bootSnapshot.magic) ||
+     (_bootSnapshot.crc != calculateCRC16((const uint8_t *)&_bootSnapshot, offsetof(sSnapshot_t, crc)))){
+    DBG("no valid snapshot");
+    return false;
+  }
+  if((RS01_BASIC_INFO_MASK != (_cacheValid & RS01_BASIC_INFO_MASK)) ||
+     (0 != memcmp(&_bootSnapshot.basicInfo, &basicInfo, sizeof(basicInfo)))){
+    DBG("snapshot stale");
+    return false;
+  }
+  measurementConfig = _bootSnapshot.measurementConfig;
+  _cacheValid |= RS01_MEASUREMENT_CONFIG_MASK;
+  return true;
+}
+
+bool DFRobot_RS01::getSnapshot(sSnapshot_t *snapshot)
+{
+  uint32_t mask = RS01_BASIC_INFO_MASK | RS01_MEASUREMENT_CONFIG_MASK;
+  if((mask != (_cacheValid & mask)) || _cacheDirty){
+    return false;
+  }
+  memset(snapshot, 0, sizeof(*snapshot));   // Padding included, so that equal states give equal bytes
+  snapshot->magic = RS01_SNAPSHOT_MAGIC;
+  snapshot->basicInfo = basicInfo;
+  snapshot->measurementConfig = measurementConfig;
+  snapshot->crc = calculateCRC16((const uint8_t *)snapshot, offsetof(sSnapshot_t, crc));
+  return true;
+}
+
+void DFRobot_RS01::setSnapshot(const sSnapshot_t *snapshot)
+{
+  _hasBootSnapshot = (NULL != snapshot);
+  if(_hasBootSnapshot){
+    _bootSnapshot = *snapshot;   // Copied, every later begin()/restart() validates it again
+  }
+}
+
+bool DFRobot_RS01::isSnapshotRestored(void)
+{
+  return _snapshotRestored;
+}
+
+void DFRobot_RS01::setWaitMode(eWaitMode_t mode)
+{
+  _waitMode = mode;
+}
+
+uint8_t DFRobot_RS01::waitReady(uint32_t timeoutMs)
+{
+  uint32_t startMs = millis();
+  uint32_t backoffMs = RS01_READY_PROBE_MIN_MS;
+  uint8_t ret = DFRobot_RTU::eRTU_RECV_ERROR;
+
+  setResponseTimeout(RS01_READY_PROBE_TIMEOUT_MS);   // A silent sensor mustn't cost the full response timeout per probe
+  while(1){
+    ret = readIdentity();
+    if((0 == ret) || (RS01_PID_MISMATCH == ret)){
+      break;   // Answered, possibly with another PID
+    }
+    if((millis() - startMs + backoffMs) > timeoutMs){
+      break;
+    }
+    delay(backoffMs);
+    if(backoffMs < RS01_READY_PROBE_MAX_MS){
+      backoffMs *= 2;
+    }
+  }
+  setResponseTimeout(_timeoutMs);   // Set the return message timeout to 500ms
+
+  return ret;
+}
+
 /***************** Sensor information reading ******************************/
 
 int DFRobot_RS01::refreshBasicInfo(void)
 {
-  return readData(RS01_PID_REG, (uint16_t *)&basicInfo, 6);
+  int ret = readData(RS01_PID_REG, (uint16_t *)&basicInfo, 6);
+  if(0 == ret){
+    _cacheValid |= RS01_BASIC_INFO_MASK;
+  }
+  return ret;
 }
 
 int DFRobot_RS01::refreshMeasurementData(void)
 {
-  return readData(RS01_TARGETS_NUMBER, dataBuf, 11);
+  int ret;
+  if(!_adaptiveRead || fullReadCheaper()){
+    if(_zeroCopyRead && (eAsyncWaitResponse != _asyncState)){
+      return readMeasurementInPlace();   // Decoded and bookkept by poll()
+    }
+    ret = readData(RS01_TARGETS_NUMBER, dataBuf, 11);
+  }else{
+    ret = readData(RS01_TARGETS_NUMBER, dataBuf, 3);   // Target count with target 1
+    if(ret){
+      return ret;
+    }
+    uint8_t count = (5 < dataBuf[0]) ? 5 : dataBuf[0];
+    if(1 < count){
+      ret = readData(RS01_DISTANCE_TARGET2, &dataBuf[3], 2 * (count - 1));
+      if(ret){
+        return ret;
+      }
+    }
+    uint8_t span = (0 == count) ? 3 : (1 + 2 * count);
+    memset(&dataBuf[span], 0, (11 - span) * sizeof(dataBuf[0]));
+  }
+
+  if(0 == ret){
+    decodeMeasurement();
+    onMeasurement();
+  }
+  return ret;
 }
 
-int DFRobot_RS01::refreshMeasurementConfig(void)
+int DFRobot_RS01::refreshMeasurementData(uint8_t maxTargets, bool withIntensity)
 {
-  return readData(MEASUREMENT_START_POSITION, (uint16_t *)&measurementConfig, 6);
+  uint8_t span = measurementSpan(maxTargets, withIntensity);
+  int ret = readData(RS01_TARGETS_NUMBER, dataBuf, span);
+  if(0 == ret){
+    memset(&dataBuf[span], 0, (11 - span) * sizeof(dataBuf[0]));   // Don't leave stale values behind the read span
+    decodeMeasurement((5 < maxTargets) ? 5 : maxTargets);
+    onMeasurement();
+  }
+  return ret;
 }
 
-/***************** Sensor basic information config ******************************/
+void DFRobot_RS01::setAdaptiveRead(bool enable)
+{
+  _adaptiveRead = enable;
+}
 
-void DFRobot_RS01::setADDR(uint16_t addr)
+void DFRobot_RS01::setStage(DFRobot_RS01Stage *stage)
 {
-  if((0x0001 <= addr) && (0x00F7 >= addr))
-  {
-    uint8_t ret = writeData(RS01_ADDR_REG, &addr, 1);
+  _stage = stage;
+}
+
+DFRobot_RS01::eChange_t DFRobot_RS01::pollForChange(int *ret)
+{
+  if(_publishedValid && ((millis() - _lastPollMs) < _pollIntervalMs)){
+    return eChangeNotDue;
+  }
+  _lastPollMs = millis();
+
+  int err = refreshMeasurementData();
+  if(ret){
+    *ret = err;
+  }
+  if(err){
+    _pollIntervalMs = _pollMinMs;   // Don't stretch the interval over a faulty link
+    return eChangeError;
+  }
+
+  if(changedSincePublished()){
+    _published = measurement;
+    _publishedValid = true;
+    _pollIntervalMs = _pollMinMs;
+    return eChangeUpdated;
+  }
+  if(_pollIntervalMs < _pollMaxMs){
+    _pollIntervalMs = (_pollIntervalMs > (_pollMaxMs / 2)) ? _pollMaxMs : ((0 == _pollIntervalMs) ? 1 : (2 * _pollIntervalMs));
+  }
+  return eChangeNone;
+}
+
+void DFRobot_RS01::setChangeDeadband(uint16_t distance, uint16_t intensity)
+{
+  _deadbandDistance = distance;
+  _deadbandIntensity = intensity;
+}
+
+void DFRobot_RS01::setPollInterval(uint32_t minMs, uint32_t maxMs)
+{
+  _pollMinMs = minMs;
+  _pollMaxMs = (maxMs < minMs) ? minMs : maxMs;
+  _pollIntervalMs = minMs;
+}
+
+uint32_t DFRobot_RS01::getPollInterval(void)
+{
+  return _pollIntervalMs;
+}
+
+void DFRobot_RS01::setSampleRate(uint16_t hz, eSamplePolicy_t policy)
+{
+  _samplePeriodUs = hz ? (1000000UL / hz) : 0;
+  _samplePolicy = policy;
+  _sampleDeadlineUs = micros();   // First read right away
+  resetSampleStats();
+}
+
+DFRobot_RS01::eSample_t DFRobot_RS01::service(int *ret)
+{
+  if(_sampleInFlight){
+    eAsyncState_t state = poll();
+    if(eAsyncWaitResponse == state){
+      return eSamplePending;
+    }
+    _sampleInFlight = false;
     if(ret){
-      DBG(ret);
+      *ret = _asyncError;
+    }
+    if(eAsyncDone != state){
+      _sampleStats.errors++;
+      return eSampleError;
+    }
+    return eSampleReady;
+  }
+  if((0 == _samplePeriodUs) || (eAsyncWaitResponse == _asyncState)){
+    return eSampleNotDue;   // Off, or a non-blocking read of the caller holds the bus
+  }
+
+  uint32_t now = micros();
+  uint32_t lateUs = now - _sampleDeadlineUs;
+  if((int32_t)lateUs < 0){
+    return eSampleNotDue;
+  }
+  uint32_t missed = lateUs / _samplePeriodUs;   // Deadlines after this one that already passed too
+  if(eSampleCatchUp == _samplePolicy){
+    missed = (RS01_SAMPLE_MAX_CATCHUP < missed) ? (missed - RS01_SAMPLE_MAX_CATCHUP) : 0;
+  }
+  if(missed){
+    _sampleStats.dropped += missed;
+    _sampleDeadlineUs += missed * _samplePeriodUs;
+    lateUs -= missed * _samplePeriodUs;
+  }
+  _sampleDeadlineUs += _samplePeriodUs;   // Absolute: the lateness of this read doesn't shift the next deadline
+
+  if(_sampleStats.samples){
+    uint32_t interval = now - _sampleIssueUs;
+    int32_t deviation = (int32_t)(interval - _samplePeriodUs);
+    _sampleStats.lastIntervalUs = interval;
+    if(interval < _sampleStats.minIntervalUs){
+      _sampleStats.minIntervalUs = interval;
+    }
+    if(interval > _sampleStats.maxIntervalUs){
+      _sampleStats.maxIntervalUs = interval;
+    }
+    _sampleStats.sumDeviationUs += deviation;
+    _sampleStats.sumSquaredDeviationUs += (uint64_t)((int64_t)deviation * deviation);
+  }
+  if(lateUs > _sampleStats.maxLatenessUs){
+    _sampleStats.maxLatenessUs = lateUs;
+  }
+  _sampleStats.samples++;
+  _sampleIssueUs = now;
+
+  int err = startMeasurementRead();
+  if(err){
+    if(ret){
+      *ret = err;
+    }
+    _sampleStats.errors++;
+    return eSampleError;
+  }
+  _sampleInFlight = true;
+  return eSamplePending;
+}
+
+void DFRobot_RS01::getSampleStats(sSampleStats_t *stats)
+{
+  *stats = _sampleStats;
+  uint32_t intervals = _sampleStats.samples ? (_sampleStats.samples - 1) : 0;
+  if(0 == intervals){
+    stats->avgIntervalUs = 0;
+    stats->stddevUs = 0;
+    return;
+  }
+  // Exact in the 64-bit sums: with sum = q * n + r, n * variance = sumSq - q^2 * n - 2 * q * r - r^2 / n,
+  // every term stays below sumSq, so nothing is lost to a float or overflows
+  int64_t q = _sampleStats.sumDeviationUs / (int64_t)intervals;
+  int64_t r = _sampleStats.sumDeviationUs - q * (int64_t)intervals;   // Same sign as q, |r| < intervals
+  uint64_t centred = _sampleStats.sumSquaredDeviationUs - (uint64_t)(q * q) * intervals - (uint64_t)(2 * q * r) -
+                     (uint64_t)(r * r) / intervals;
+  stats->avgIntervalUs = (uint32_t)((int64_t)_samplePeriodUs + q);
+  stats->stddevUs = isqrt(centred / intervals);
+}
+
+uint32_t DFRobot_RS01::isqrt(uint64_t value)
+{
+  uint64_t root = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+  while(bit > value){
+    bit >>= 2;
+  }
+  while(bit){   // Digit by digit, two bits of the radicand per bit of the root
+    if(value >= root + bit){
+      value -= root + bit;
+      root = (root >> 1) + bit;
     }else{
-      basicInfo.modbusAddr = addr;
+      root >>= 1;
     }
+    bit >>= 2;
   }
-  delay(100);
+  return (uint32_t)root;
 }
 
-void DFRobot_RS01::setBaudrateMode(eBaudrateMode_t mode)
+void DFRobot_RS01::resetSampleStats(void)
 {
-  uint8_t ret = writeData(RS01_BAUDRATE_REG, &mode, 1);
-  if(ret){
-    DBG(ret);
-  }else{
-    basicInfo.baudrate = mode;
+  memset(&_sampleStats, 0, sizeof(_sampleStats));
+  _sampleStats.minIntervalUs = 0xFFFFFFFF;
+}
+
+bool DFRobot_RS01::changedSincePublished(void)
+{
+  if(!_publishedValid || (measurement.targetCount != _published.targetCount)){
+    return true;
+  }
+  for(uint8_t i = 0; i < measurement.targetCount; i++){
+    uint16_t d = (measurement.distance[i] > _published.distance[i]) ?
+                 (measurement.distance[i] - _published.distance[i]) : (_published.distance[i] - measurement.distance[i]);
+    uint16_t s = (measurement.intensity[i] > _published.intensity[i]) ?
+                 (measurement.intensity[i] - _published.intensity[i]) : (_published.intensity[i] - measurement.intensity[i]);
+    if((d > _deadbandDistance) || (s > _deadbandIntensity)){
+      return true;
+    }
   }
-  delay(100);
+  return false;
 }
 
+void DFRobot_RS01::setZeroCopyRead(bool enable)
+{
+  _zeroCopyRead = enable;
+}
 
-void DFRobot_RS01::setCheckbitStopbit(uint16_t mode)
+int DFRobot_RS01::readMeasurementInPlace(void)
 {
-  uint8_t ret = writeData(RS01_CHECKBIT_STOPBIT_REG, &mode, 1);
-  if(ret){
-    DBG(ret);
-  }else{
-    basicInfo.checkbit = (uint8_t)((mode & 0xFF00) >> 8);
-    basicInfo.stopbit = (uint8_t)(mode & 0x00FF);
+  uint8_t attempt = 0;
+  do{
+    int ret = startMeasurementRead();
+    if(ret){
+      return ret;
+    }
+    _asyncBlocking = true;
+    while(eAsyncWaitResponse == poll()){
+      yield();
+    }
+  }while(retryAfter(false, _asyncError, &attempt));
+  return _asyncError;
+}
+
+bool DFRobot_RS01::fullReadCheaper(void)
+{
+  uint32_t total = 0;
+  uint32_t twoPhase = 0;
+  for(uint8_t n = 0; n <= 5; n++){
+    total += _targetProfile[n];
+    twoPhase += (uint32_t)_targetProfile[n] * (RS01_FRAME_OVERHEAD_BYTES + 2 * 3);   // Count with target 1
+    if(1 < n){
+      twoPhase += (uint32_t)_targetProfile[n] * (RS01_FRAME_OVERHEAD_BYTES + 4 * (n - 1));   // Follow-up for targets 2~n
+    }
+  }
+  if(0 == total){
+    return false;   // Nothing learnt yet, the short frame is never worse for a single target
   }
-  delay(100);
+  return (total * (RS01_FRAME_OVERHEAD_BYTES + 2 * 11)) < twoPhase;
 }
 
-/***************** Sensor measurement parameters config ******************************/
+void DFRobot_RS01::getSample(sSample_t *sample)
+{
+  sample->timestamp = _sampleUs;
+  sample->targetCount = measurement.targetCount;
+  memcpy(sample->distance, measurement.distance, sizeof(sample->distance));
+  memcpy(sample->intensity, measurement.intensity, sizeof(sample->intensity));
+}
+
+uint32_t DFRobot_RS01::getSampleTimestamp(void)
+{
+  return _sampleUs;
+}
 
-void DFRobot_RS01::setAllMeasurementParameters(uint16_t startingPosition, uint16_t stopPosition,
-                                                  uint16_t initialThreshold, uint16_t endThreshold,
-                                                  uint16_t moduleSensitivity, uint16_t comparisonOffset)
+int8_t DFRobot_RS01::nearestTarget(uint16_t minIntensity)
 {
-  if(readData(MEASUREMENT_START_POSITION, (uint16_t *)&measurementConfig, 6)){
-    DBG();
+  for(uint8_t i = 0; i < measurement.targetCount; i++){   // The sensor reports the targets nearest first
+    if(measurement.intensity[i] >= minIntensity){
+      return (int8_t)i;
+    }
   }
-  delay(100);
+  return -1;
+}
 
-  if((0x0046 <= startingPosition) && (measurementConfig.stopPosition >= startingPosition))
-  {
-    measurementConfig.startPosition = startingPosition;   // Measurement start position set value
+#if defined(ESP32)
+/***************** background acquisition(ESP32 only) ******************************/
+
+int DFRobot_RS01::startBackgroundAcquisition(uint32_t periodMs, uint8_t core)
+{
+  if(((NULL == _DFRobot_RTU) && (NULL == _transport)) || (NULL != _taskHandle)){
+    DBG("task running or not initialized");
+    return DFRobot_RTU::eRTU_RECV_ERROR;
   }
 
-  if((measurementConfig.startPosition <= stopPosition) && (0x19C8 >= stopPosition))
-  {
-    measurementConfig.stopPosition = stopPosition;   // Measurement stop position set value
+  _taskPeriodMs = (0 == periodMs) ? 1 : periodMs;
+  _taskRun = true;
+  if(pdPASS != xTaskCreatePinnedToCore(acquisitionTask, "RS01", RS01_TASK_STACK_SIZE, this,
+                                       RS01_TASK_PRIORITY, &_taskHandle, core)){
+    _taskHandle = NULL;
+    _taskRun = false;
+    return DFRobot_RTU::eRTU_MEMORY_ERROR;
   }
+  return 0;
+}
 
-  if((0x0064 <= initialThreshold) && (0x2710 >= initialThreshold) && (0 < int16_t(initialThreshold + measurementConfig.comparisonOffset)))
-  {
-    measurementConfig.initialThreshold = initialThreshold;   // Initial threshold set value
+void DFRobot_RS01::stopBackgroundAcquisition(void)
+{
+  _taskRun = false;
+}
+
+bool DFRobot_RS01::readSnapshot(sSample_t *sample)
+{
+  uint32_t seq;
+  do{
+    while((seq = _snapSeq) & 1){   // Writer in progress on the other core
+      yield();
+    }
+    __sync_synchronize();
+    *sample = _snapshot;
+    __sync_synchronize();
+  }while(seq != _snapSeq);   // The writer came by while copying, try again
+  return 0 != seq;
+}
+
+void DFRobot_RS01::acquisitionTask(void *arg)
+{
+  DFRobot_RS01 *self = (DFRobot_RS01 *)arg;
+  TickType_t wake = xTaskGetTickCount();
+
+  while(self->_taskRun){
+    if(0 == self->refreshMeasurementData()){
+      self->_snapSeq++;   // Odd: readers wait
+      __sync_synchronize();
+      self->getSample(&self->_snapshot);
+      __sync_synchronize();
+      self->_snapSeq++;   // Even: the snapshot is consistent again
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(self->_taskPeriodMs));
   }
 
-  if((0x0064 <= endThreshold) && (0x2710 >= endThreshold) && (0 < int16_t(endThreshold + measurementConfig.comparisonOffset)))
-  {
-    measurementConfig.endThreshold = endThreshold;   // End threshold set value
+  self->_taskHandle = NULL;
+  vTaskDelete(NULL);
+}
+#endif
+
+void DFRobot_RS01::decodeMeasurement(uint8_t readTargets)
+{
+  _readTargets = readTargets;
+  measurement.targetCount = (readTargets < dataBuf[0]) ? readTargets : (uint8_t)dataBuf[0];   // Zeros behind a partial read aren't targets
+  for(uint8_t i = 0; i < 5; i++){
+    measurement.distance[i] = dataBuf[1 + 2 * i];
+    measurement.intensity[i] = dataBuf[2 + 2 * i];
   }
+}
 
-  if(0x0004 >= moduleSensitivity)
-  {
-    measurementConfig.moduleSensitivity = moduleSensitivity;   // Module sensitivity set value
+void DFRobot_RS01::onMeasurement(void)
+{
+  _sampleUs = micros();
+  profileTargets(dataBuf[0]);   // What the sensor reported, not what was read of it
+  for(DFRobot_RS01Stage *stage = _stage; stage; stage = stage->getNext()){
+    stage->process(*this, measurement);
   }
+}
 
-  if((0 < int16_t(measurementConfig.initialThreshold + comparisonOffset)) && (0 < int16_t(comparisonOffset + measurementConfig.endThreshold)))
-  {
-    measurementConfig.comparisonOffset = comparisonOffset;   // Comparison offset set value
+void DFRobot_RS01::profileTargets(uint16_t count)
+{
+  if(5 < count){
+    count = 5;
+  }
+  if(0xFF == _targetProfile[count]){
+    for(uint8_t n = 0; n <= 5; n++){
+      _targetProfile[n] >>= 1;
+    }
   }
+  _targetProfile[count]++;
+}
+
+uint8_t DFRobot_RS01::getReadTargets(void)
+{
+  return _readTargets;
+}
 
-  if(writeData(MEASUREMENT_START_POSITION, &measurementConfig, 6)){
-    DBG();
+uint8_t DFRobot_RS01::measurementSpan(uint8_t maxTargets, bool withIntensity)
+{
+  if(0 == maxTargets){
+    return 1;
+  }
+  if(5 < maxTargets){
+    maxTargets = 5;
   }
-  delay(100);
+  return 1 + 2 * maxTargets - (withIntensity ? 0 : 1);
 }
 
-void DFRobot_RS01::restoreFactorySetting(void)
+int DFRobot_RS01::refreshMeasurementConfig(void)
 {
-  uint16_t value = 0x0000;   // To zero out the register is a soft reset
-  if(writeData(RS01_RESET_FACTORY, &value, 1)){
-    DBG();
+  int ret = readData(MEASUREMENT_START_POSITION, (uint16_t *)&measurementConfig, 6);
+  if(0 == ret){
+    _cacheValid |= RS01_MEASUREMENT_CONFIG_MASK;
   }
+  return ret;
 }
 
-/************ Modbus-RTU interface init and read/write ***********/
+int DFRobot_RS01::refreshAll(void)
+{
+  uint16_t regs[RS01_ALL_REGS];
+  int ret = readData(RS01_PID_REG, regs, RS01_ALL_REGS);
+  if((DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_ADDRESS == ret) || (DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE == ret)){
+    DBG("bulk read rejected, reading the three blocks");
+    ret = refreshBasicInfo();
+    if(0 == ret){
+      ret = refreshMeasurementData();
+    }
+    if(0 == ret){
+      ret = refreshMeasurementConfig();
+    }
+    return ret;
+  }
+  if(ret){
+    return ret;
+  }
 
-uint8_t DFRobot_RS01::readData(uint16_t reg, uint16_t * pBuf, uint8_t size)
+  memcpy(&basicInfo, &regs[RS01_PID_REG], 6 * sizeof(uint16_t));
+  memcpy(dataBuf, &regs[RS01_TARGETS_NUMBER], 11 * sizeof(uint16_t));
+  memcpy(&measurementConfig, &regs[MEASUREMENT_START_POSITION], 6 * sizeof(uint16_t));
+  _cacheValid |= RS01_BASIC_INFO_MASK | RS01_MEASUREMENT_CONFIG_MASK;
+  decodeMeasurement();
+  onMeasurement();
+  return ret;
+}
+
+/***************** Sensor basic information config ******************************/
+
+uint8_t DFRobot_RS01::setADDR(uint16_t addr)
 {
-  if(NULL == pBuf)
+  if((0x0001 > addr) || (0x00F7 < addr))
   {
-    DBG("pBuf ERROR!! : null pointer");
+    DBG("Invaild Device addr.");
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
   }
-  uint8_t ret = _DFRobot_RTU->readHoldingRegister(basicInfo.modbusAddr, reg, pBuf, size);
+  _cacheDirty &= ~RS01_REG_BIT(RS01_ADDR_REG);   // The setter supersedes a staged value
+  if(cacheHolds(RS01_ADDR_REG, addr)){
+    return 0;   // Already set, skip the write
+  }
+
+  uint8_t ret = writeData(RS01_ADDR_REG, &addr, 1);
   if(ret){
     DBG(ret);
+  }else{
+    basicInfo.modbusAddr = addr;
+    _cacheValid |= RS01_REG_BIT(RS01_ADDR_REG);
   }
-  // delay(100);
+  settle();
   return ret;
 }
 
-uint8_t DFRobot_RS01::writeData(uint16_t reg, const void * pBuf, uint8_t size)
+uint8_t DFRobot_RS01::setBaudrateMode(eBaudrateMode_t mode)
 {
-  if(NULL == pBuf)
-  {
-    DBG("pBuf ERROR!! : null pointer");
+  uint16_t value = mode;
+  _cacheDirty &= ~RS01_REG_BIT(RS01_BAUDRATE_REG);   // The setter supersedes a staged value
+  if(cacheHolds(RS01_BAUDRATE_REG, value)){
+    return 0;   // Already set, skip the write
+  }
+
+  uint8_t ret = writeData(RS01_BAUDRATE_REG, &value, 1);
+  if(ret){
+    DBG(ret);
+  }else{
+    basicInfo.baudrate = mode;
+    _cacheValid |= RS01_REG_BIT(RS01_BAUDRATE_REG);
   }
+  settle();
+  return ret;
+}
 
-  uint8_t ret = _DFRobot_RTU->writeHoldingRegister(basicInfo.modbusAddr, reg, (uint16_t *)pBuf, size);
+
+uint8_t DFRobot_RS01::setCheckbitStopbit(uint16_t mode)
+{
+  if(!checkbitStopbitValid(mode)){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  _cacheDirty &= ~RS01_REG_BIT(RS01_CHECKBIT_STOPBIT_REG);   // The setter supersedes a staged value
+  if(cacheHolds(RS01_CHECKBIT_STOPBIT_REG, mode)){
+    return 0;   // Already set, skip the write
+  }
+
+  uint8_t ret = writeData(RS01_CHECKBIT_STOPBIT_REG, &mode, 1);
+  if(ret){
+    DBG(ret);
+  }else{
+    basicInfo.checkbit = (uint8_t)((mode & 0xFF00) >> 8);
+    basicInfo.stopbit = (uint8_t)(mode & 0x00FF);
+    _cacheValid |= RS01_REG_BIT(RS01_CHECKBIT_STOPBIT_REG);
+  }
+  settle();
+  return ret;
+}
+
+DFRobot_RS01::eNegotiateResult_t DFRobot_RS01::negotiateBaudrate(hostBaudrate_t hostBaudrate, powerCycle_t powerCycle,
+                                                                 eBaudrateMode_t maxMode)
+{
+  return negotiate(hostBaudrate, powerCycle, maxMode, 0);
+}
+
+DFRobot_RS01::eNegotiateResult_t DFRobot_RS01::negotiate(hostBaudrate_t hostBaudrate, powerCycle_t powerCycle,
+                                                         eBaudrateMode_t maxMode, uint8_t depth)
+{
+  if(!findBaudrate(hostBaudrate)){
+    return eNegotiateNoSensor;
+  }
+  eBaudrateMode_t current = (eBaudrateMode_t)basicInfo.baudrate;
+
+  if(verifyLink(RS01_NEGOTIATE_BURST) > RS01_NEGOTIATE_MAX_ERRORS){
+    /* The sensor answers but not reliably, e.g. after a previous step up: step back down */
+    if((eBaudrate2400 == current) || (depth > eBaudrate_1000000)){
+      return eNegotiateOk;   // Nothing slower to try, or the step down never takes
+    }
+    eBaudrateMode_t lower = (eBaudrateMode_t)(current - 1);
+    _baudrateCeiling = lower;   // Kept across calls: the restart the caller does mustn't lead to climbing again
+    for(uint8_t i = 0; i < 3; i++){
+      if(0 == setBaudrateMode(lower)){
+        break;
+      }
+    }
+    if(NULL == powerCycle){
+      return eNegotiateRestartNeeded;
+    }
+    powerCycle();
+    return negotiate(hostBaudrate, powerCycle, maxMode, depth + 1);
+  }
+
+  if(maxMode > _baudrateCeiling){
+    maxMode = (eBaudrateMode_t)_baudrateCeiling;
+  }
+  while(current < maxMode){
+    eBaudrateMode_t next = (eBaudrateMode_t)(current + 1);
+    if(0 != setBaudrateMode(next)){
+      break;
+    }
+    if(NULL == powerCycle){
+      return eNegotiateRestartNeeded;   // The next call verifies the new rate
+    }
+
+    powerCycle();
+    hostBaudrate(baudrateOf(next));
+    bool answered = (0 == waitReady(RS01_READY_TIMEOUT_MS));
+    if(answered && (verifyLink(RS01_NEGOTIATE_BURST) <= RS01_NEGOTIATE_MAX_ERRORS)){
+      current = next;
+      continue;
+    }
+
+    /* The candidate failed: stop climbing, roll back over the flaky link unless it is dead */
+    _baudrateCeiling = current;
+    if(answered){
+      for(uint8_t i = 0; i < 3; i++){
+        if(0 == setBaudrateMode(current)){
+          break;
+        }
+      }
+      powerCycle();
+      hostBaudrate(baudrateOf(current));
+      if(0 == waitReady(RS01_READY_TIMEOUT_MS)){
+        break;
+      }
+    }
+    return negotiate(hostBaudrate, powerCycle, maxMode, depth + 1);   // Find the sensor wherever it ended up, the ceiling stops the climb
+  }
+
+  basicInfo.baudrate = current;
+  return eNegotiateOk;
+}
+
+uint32_t DFRobot_RS01::baudrateOf(eBaudrateMode_t mode)
+{
+  switch(mode){
+    case eBaudrate2400: return 2400;
+    case eBaudrate4800: return 4800;
+    case eBaudrate9600: return 9600;
+    case eBaudrate14400: return 14400;
+    case eBaudrate19200: return 19200;
+    case eBaudrate38400: return 38400;
+    case eBaudrate57600: return 57600;
+    case eBaudrate115200: return 115200;
+    case eBaudrate_1000000: return 1000000;
+    default: return 0;
+  }
+}
+
+bool DFRobot_RS01::findBaudrate(hostBaudrate_t hostBaudrate)
+{
+  _cacheValid &= ~RS01_REG_BIT(RS01_BAUDRATE_REG);   // basicInfo.baudrate now tells the running rate, not the register
+  hostBaudrate(115200);
+  if(0 == verifyLink(1)){
+    basicInfo.baudrate = eBaudrate115200;
+    return true;
+  }
+  for(uint8_t mode = eBaudrate_1000000; mode >= eBaudrate2400; mode--){
+    if(eBaudrate115200 == mode){
+      continue;
+    }
+    hostBaudrate(baudrateOf((eBaudrateMode_t)mode));
+    if(0 == verifyLink(1)){
+      basicInfo.baudrate = mode;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint8_t DFRobot_RS01::verifyLink(uint8_t reads)
+{
+  uint8_t errors = 0;
+  setResponseTimeout(RS01_READY_PROBE_TIMEOUT_MS);
+  for(uint8_t i = 0; i < reads; i++){
+    uint16_t pid = 0;
+    if((0 != readData(RS01_PID_REG, &pid, 1)) || (RS01_PID != pid)){
+      errors++;
+    }
+  }
+  setResponseTimeout(_timeoutMs);
+  return errors;
+}
+
+/***************** Sensor measurement parameters config ******************************/
+
+uint8_t DFRobot_RS01::setAllMeasurementParameters(uint16_t startingPosition, uint16_t stopPosition,
+                                                     uint16_t initialThreshold, uint16_t endThreshold,
+                                                     uint16_t moduleSensitivity, uint16_t comparisonOffset)
+{
+  bool broadcast = (RS01_BROADCAST_ADDR == basicInfo.modbusAddr);   // Nothing can be read back, measurementConfig is the base
+  if(!broadcast && (RS01_MEASUREMENT_CONFIG_MASK != (_cacheValid & RS01_MEASUREMENT_CONFIG_MASK))){   // Trust the cache, read only when it is stale
+    uint8_t ret = refreshMeasurementConfig();
+    if(ret){
+      DBG(ret);
+      return ret;
+    }
+    settle();
+  }
+  _cacheDirty &= ~RS01_MEASUREMENT_CONFIG_MASK;   // The whole block is written, staged values are superseded
+  sMeasurementConfig_t previous = measurementConfig;
+
+  if((0x0046 <= startingPosition) && (measurementConfig.stopPosition >= startingPosition))
+  {
+    measurementConfig.startPosition = startingPosition;   // Measurement start position set value
+  }
+
+  if((measurementConfig.startPosition <= stopPosition) && (0x19C8 >= stopPosition))
+  {
+    measurementConfig.stopPosition = stopPosition;   // Measurement stop position set value
+  }
+
+  if((0x0064 <= initialThreshold) && (0x2710 >= initialThreshold) && (0 < int16_t(initialThreshold + measurementConfig.comparisonOffset)))
+  {
+    measurementConfig.initialThreshold = initialThreshold;   // Initial threshold set value
+  }
+
+  if((0x0064 <= endThreshold) && (0x2710 >= endThreshold) && (0 < int16_t(endThreshold + measurementConfig.comparisonOffset)))
+  {
+    measurementConfig.endThreshold = endThreshold;   // End threshold set value
+  }
+
+  if(0x0004 >= moduleSensitivity)
+  {
+    measurementConfig.moduleSensitivity = moduleSensitivity;   // Module sensitivity set value
+  }
+
+  if((0 < int16_t(measurementConfig.initialThreshold + comparisonOffset)) && (0 < int16_t(comparisonOffset + measurementConfig.endThreshold)))
+  {
+    measurementConfig.comparisonOffset = comparisonOffset;   // Comparison offset set value
+  }
+
+  if(!broadcast && (0 == memcmp(&previous, &measurementConfig, sizeof(previous)))){
+    return 0;   // Nothing changed, skip the write
+  }
+  uint8_t ret = writeData(MEASUREMENT_START_POSITION, &measurementConfig, 6);
+  if(ret){
+    DBG(ret);
+    measurementConfig = previous;   // Keep the cache in line with the sensor
+  }
+  settle();
+  return ret;
+}
+
+uint8_t DFRobot_RS01::restoreFactorySetting(void)
+{
+  uint16_t value = 0x0000;   // To zero out the register is a soft reset
+  uint8_t ret = writeData(RS01_RESET_FACTORY, &value, 1);
+  if(ret){
+    DBG(ret);
+  }
+  invalidateConfigCache();
+  return ret;
+}
+
+uint8_t DFRobot_RS01::setStartPosition(uint16_t value)
+{
+  bool known = _cacheValid & RS01_REG_BIT(MEASUREMENT_END_POSITION);
+  if((0x0046 > value) || ((known ? measurementConfig.stopPosition : 0x19C8) < value)){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  return writeConfigRegister(MEASUREMENT_START_POSITION, value);
+}
+
+uint8_t DFRobot_RS01::setStopPosition(uint16_t value)
+{
+  bool known = _cacheValid & RS01_REG_BIT(MEASUREMENT_START_POSITION);
+  if(((known ? measurementConfig.startPosition : 0x0046) > value) || (0x19C8 < value)){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  return writeConfigRegister(MEASUREMENT_END_POSITION, value);
+}
+
+uint8_t DFRobot_RS01::setInitialThreshold(uint16_t value)
+{
+  bool known = _cacheValid & RS01_REG_BIT(RS01_COMPARISON_OFFSET);
+  if((0x0064 > value) || (0x2710 < value) || (known && (0 >= int16_t(value + measurementConfig.comparisonOffset)))){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  return writeConfigRegister(RS01_START_THRESHOLD, value);
+}
+
+uint8_t DFRobot_RS01::setEndThreshold(uint16_t value)
+{
+  bool known = _cacheValid & RS01_REG_BIT(RS01_COMPARISON_OFFSET);
+  if((0x0064 > value) || (0x2710 < value) || (known && (0 >= int16_t(value + measurementConfig.comparisonOffset)))){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  return writeConfigRegister(RS01_END_THRESHOLD, value);
+}
+
+uint8_t DFRobot_RS01::setSensitivity(uint16_t value)
+{
+  if(0x0004 < value){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  return writeConfigRegister(RS01_MODULE_SENSITIVITY, value);
+}
+
+uint8_t DFRobot_RS01::setComparisonOffset(int16_t value)
+{
+  if((_cacheValid & RS01_REG_BIT(RS01_START_THRESHOLD)) && (0 >= int16_t(measurementConfig.initialThreshold + value))){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  if((_cacheValid & RS01_REG_BIT(RS01_END_THRESHOLD)) && (0 >= int16_t(measurementConfig.endThreshold + value))){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  return writeConfigRegister(RS01_COMPARISON_OFFSET, (uint16_t)value);
+}
+
+uint8_t DFRobot_RS01::writeConfigRegister(uint16_t reg, uint16_t value)
+{
+  _cacheDirty &= ~RS01_REG_BIT(reg);   // The setter supersedes a staged value
+  if(cacheHolds(reg, value)){
+    return 0;   // Already set, skip the write
+  }
+  uint8_t ret = writeData(reg, &value, 1);
+  if(ret){
+    DBG(ret);
+  }else{
+    *cacheWord(reg) = value;
+    _cacheValid |= RS01_REG_BIT(reg);
+  }
+  settle();
+  return ret;
+}
+
+/***************** configuration cache ******************************/
+
+uint8_t DFRobot_RS01::stageConfig(uint16_t reg, uint16_t value)
+{
+  uint16_t low = 0, high = 0xFFFF;
+  switch(reg){
+    case RS01_ADDR_REG:               low = 0x0001; high = 0x00F7; break;
+    case RS01_BAUDRATE_REG:           low = eBaudrate2400; high = eBaudrate_1000000; break;
+    case RS01_CHECKBIT_STOPBIT_REG:
+      if(!checkbitStopbitValid(value)){
+        return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;   // A bad frame format only shows after the next power cycle
+      }
+      break;
+    case MEASUREMENT_START_POSITION:
+    case MEASUREMENT_END_POSITION:    low = 0x0046; high = 0x19C8; break;
+    case RS01_START_THRESHOLD:
+    case RS01_END_THRESHOLD:          low = 0x0064; high = 0x2710; break;
+    case RS01_MODULE_SENSITIVITY:     low = 0x0000; high = 0x0004; break;
+    case RS01_COMPARISON_OFFSET:      break;
+    default:
+      return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+  }
+  if((value < low) || (value > high)){
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+
+  if(cacheHolds(reg, value)){
+    _cacheDirty &= ~RS01_REG_BIT(reg);   // Back to the value the sensor holds, nothing to write
+  }else{
+    _staged[stagedSlot(reg)] = value;
+    _cacheDirty |= RS01_REG_BIT(reg);
+  }
+  return 0;
+}
+
+uint8_t DFRobot_RS01::commit(void)
+{
+  if((_cacheDirty & RS01_MEASUREMENT_CONFIG_MASK) && !stagedConfigValid()){
+    DBG("staged measurement parameters inconsistent");
+    return DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE;
+  }
+  /* Measurement parameters first, the link settings next, the address last as it redirects the following writes */
+  uint8_t ret = commitRange(MEASUREMENT_START_POSITION, RS01_COMPARISON_OFFSET);
+  if(0 == ret){
+    ret = commitRange(RS01_BAUDRATE_REG, RS01_CHECKBIT_STOPBIT_REG);
+  }
+  if(0 == ret){
+    ret = commitRange(RS01_ADDR_REG, RS01_ADDR_REG);
+  }
+  return ret;
+}
+
+void DFRobot_RS01::invalidateConfigCache(void)
+{
+  _cacheValid = 0;
+}
+
+bool DFRobot_RS01::cacheHolds(uint16_t reg, uint16_t value)
+{
+  if(RS01_BROADCAST_ADDR == basicInfo.modbusAddr){
+    return false;   // The slaves may hold anything, always write
+  }
+  return (_cacheValid & RS01_REG_BIT(reg)) && (*cacheWord(reg) == value);
+}
+
+uint16_t *DFRobot_RS01::cacheWord(uint16_t reg)
+{
+  if(MEASUREMENT_START_POSITION <= reg){
+    return (uint16_t *)&measurementConfig + (reg - MEASUREMENT_START_POSITION);
+  }
+  return (uint16_t *)&basicInfo + reg;   // stopbit and checkbit share register 4 as its low and high byte
+}
+
+uint8_t DFRobot_RS01::stagedSlot(uint16_t reg)
+{
+  if(MEASUREMENT_START_POSITION <= reg){
+    return 3 + (reg - MEASUREMENT_START_POSITION);
+  }
+  return reg - RS01_ADDR_REG;
+}
+
+bool DFRobot_RS01::checkbitStopbitValid(uint16_t mode)
+{
+  uint16_t checkbit = mode & 0xFF00;
+  uint16_t stopbit = mode & 0x00FF;
+  return ((eCheckBitNone == checkbit) || (eCheckBitEven == checkbit) || (eCheckBitOdd == checkbit)) &&
+         ((eStopBit1 == stopbit) || (eStopBit2 == stopbit));
+}
+
+bool DFRobot_RS01::stagedConfigValid(void)
+{
+  uint16_t value[6];   // start, stop, initial threshold, end threshold, sensitivity, offset as commit() leaves them
+  uint8_t known = 0;
+  for(uint8_t i = 0; i < 6; i++){
+    uint16_t reg = MEASUREMENT_START_POSITION + i;
+    if(_cacheDirty & RS01_REG_BIT(reg)){
+      value[i] = _staged[stagedSlot(reg)];
+    }else if(_cacheValid & RS01_REG_BIT(reg)){
+      value[i] = *cacheWord(reg);
+    }else{
+      continue;   // Unknown, the sensor checks it
+    }
+    known |= (1 << i);
+  }
+  if((0x03 == (known & 0x03)) && (value[0] > value[1])){
+    return false;
+  }
+  if((0x24 == (known & 0x24)) && (0 >= int16_t(value[2] + value[5]))){
+    return false;
+  }
+  if((0x28 == (known & 0x28)) && (0 >= int16_t(value[3] + value[5]))){
+    return false;
+  }
+  return true;
+}
+
+uint8_t DFRobot_RS01::commitRange(uint16_t first, uint16_t last)
+{
+  uint16_t reg = first;
+  while(reg <= last){
+    if(0 == (_cacheDirty & RS01_REG_BIT(reg))){
+      reg++;
+      continue;
+    }
+
+    uint16_t end = reg;   // Extend the run over the following dirty registers
+    while((end < last) && (_cacheDirty & RS01_REG_BIT(end + 1))){
+      end++;
+    }
+    uint8_t count = end - reg + 1;
+    uint8_t ret = writeData(reg, &_staged[stagedSlot(reg)], count);
+    settle();
+    if(ret){
+      DBG(ret);
+      return ret;   // The registers stay dirty, commit() can be called again
+    }
+    for(uint16_t r = reg; r <= end; r++){
+      *cacheWord(r) = _staged[stagedSlot(r)];
+      _cacheDirty &= ~RS01_REG_BIT(r);
+      _cacheValid |= RS01_REG_BIT(r);
+    }
+    reg = end + 1;
+  }
+  return 0;
+}
+
+void DFRobot_RS01::settle(void)
+{
+  if(eWaitFixedDelay == _waitMode){
+    delay(100);
+  }
+}
+
+/***************** non-blocking measurement read ******************************/
+
+int DFRobot_RS01::startMeasurementRead(void)
+{
+  if(((NULL == _stream) && (NULL == _transport)) || (eAsyncWaitResponse == _asyncState) ||
+     (RS01_BROADCAST_ADDR == basicInfo.modbusAddr)){
+    DBG("async read busy or not initialized");
+    return DFRobot_RTU::eRTU_RECV_ERROR;
+  }
+  if(!circuitAllows(false)){
+    return DFRobot_RTU::eRTU_RECV_ERROR;
+  }
+  applyTimeout();
+
+  if(_transport){   // Queue it, the transport sends it when it has room and parses the response
+    _asyncTransaction.addr = (uint8_t)basicInfo.modbusAddr;
+    _asyncTransaction.function = 0x03;
+    _asyncTransaction.reg = RS01_TARGETS_NUMBER;
+    _asyncTransaction.count = 11;
+    _asyncTransaction.pBuf = dataBuf;
+    _asyncTransaction.callback = onTransportComplete;
+    _asyncTransaction.context = this;
+    _asyncTransaction.timeoutMs = transactionTimeout();
+    _asyncError = 0;
+    _asyncBlocking = false;
+    _asyncStartMs = millis();
+    _asyncStartUs = micros();
+    _asyncState = eAsyncWaitResponse;
+    if(!_transport->submit(&_asyncTransaction)){
+      _asyncState = eAsyncIdle;
+      return DFRobot_RTU::eRTU_MEMORY_ERROR;
+    }
+    return 0;
+  }
+
+  while(_stream->available() > 0){   // Drop stale bytes so they can't be taken for the response
+    _stream->read();
+  }
+
+  uint8_t frame[8];
+  frame[0] = (uint8_t)basicInfo.modbusAddr;
+  frame[1] = 0x03;   // Read holding register
+  frame[2] = (uint8_t)(RS01_TARGETS_NUMBER >> 8);
+  frame[3] = (uint8_t)(RS01_TARGETS_NUMBER & 0xFF);
+  frame[4] = 0x00;
+  frame[5] = 11;
+  uint16_t crc = calculateCRC16(frame, 6);
+  frame[6] = (uint8_t)(crc & 0xFF);
+  frame[7] = (uint8_t)(crc >> 8);
+  _stream->write(frame, sizeof(frame));
+
+  _rxLen = 0;
+  _rxExpected = 0;
+  _rxCrc = 0xFFFF;
+  _asyncError = 0;
+  _asyncBlocking = false;
+  _asyncStartMs = millis();
+  _asyncStartUs = micros();
+  _asyncState = eAsyncWaitResponse;
+  return 0;
+}
+
+DFRobot_RS01::eAsyncState_t DFRobot_RS01::poll(void)
+{
+  if(eAsyncWaitResponse != _asyncState){
+    return _asyncState;
+  }
+  if(_transport){
+    _transport->service();   // Completes through onTransportComplete(), the transport keeps the timeout
+    return _asyncState;
+  }
+
+  int avail;
+  while((avail = _stream->available()) > 0){
+    if(_rxExpected){   // Header known: take the rest of the frame in bulk, straight into place
+      uint8_t want = _rxExpected - _rxLen;
+      uint8_t n = _stream->readBytes(&_rxBuf[_rxLen], (avail < want) ? avail : want);
+      for(uint8_t i = 0; i < n; i++){
+        _rxCrc = updateCRC16(_rxCrc, _rxBuf[_rxLen + i]);
+      }
+      _rxLen += n;
+    }else{
+      uint8_t c = (uint8_t)_stream->read();
+      if((0 == _rxLen) && (c != (uint8_t)basicInfo.modbusAddr)){
+        continue;   // Skip noise until the slave address shows up
+      }
+      _rxBuf[_rxLen++] = c;
+      _rxCrc = updateCRC16(_rxCrc, c);
+
+      if(3 == _rxLen){
+        if(0x83 == _rxBuf[1]){   // Exception response: addr, 0x83, code, CRC
+          _rxExpected = 5;
+        }else if((0x03 == _rxBuf[1]) && ((2 * 11) == _rxBuf[2])){
+          _rxExpected = 5 + 2 * 11;
+        }else{
+          _rxLen = 0;   // Not our frame, resync on the next address byte
+          _rxCrc = 0xFFFF;
+          continue;
+        }
+      }
+    }
+
+    if(_rxExpected && (_rxLen == _rxExpected)){
+      if(0 != _rxCrc){   // The CRC over a frame including its own CRC is 0
+        finishAsync(DFRobot_RTU::eRTU_EXCEPTION_CRC_ERROR);
+      }else if(0x83 == _rxBuf[1]){
+        finishAsync(_rxBuf[2]);
+      }else{
+        for(uint8_t i = 0; i < 11; i++){   // Straight from the frame, no copy through the RTU layer
+          dataBuf[i] = ((uint16_t)_rxBuf[3 + 2 * i] << 8) | _rxBuf[4 + 2 * i];
+        }
+        decodeMeasurement();   // A full frame, also ends a partial read span left by refreshMeasurementData()
+        onMeasurement();
+        finishAsync(0);
+      }
+      return _asyncState;
+    }
+  }
+
+  if((millis() - _asyncStartMs) > getResponseTimeout()){
+    finishAsync(DFRobot_RTU::eRTU_RECV_ERROR);
+  }
+  return _asyncState;
+}
+
+bool DFRobot_RS01::isMeasurementReady(void)
+{
+  bool ready = _asyncReady;
+  _asyncReady = false;
+  return ready;
+}
+
+uint8_t DFRobot_RS01::getAsyncError(void)
+{
+  return _asyncError;
+}
+
+DFRobot_RS01::eAsyncState_t DFRobot_RS01::getAsyncState(void)
+{
+  return _asyncState;
+}
+
+uint32_t DFRobot_RS01::getAsyncDoneUs(void)
+{
+  return _asyncDoneUs;
+}
+
+void DFRobot_RS01::setMeasurementCallback(measurementCallback_t callback)
+{
+  _measurementCallback = callback;
+}
+
+void DFRobot_RS01::finishAsync(uint8_t ret)
+{
+  _asyncDoneUs = micros();
+  uint32_t us = _asyncDoneUs - _asyncStartUs;
+  recordTransaction(false, ret, us);
+  linkResult(ret, us);
+  _asyncError = ret;
+  if(ret){
+    DBG(ret);
+    _asyncState = eAsyncError;
+  }else{
+    _asyncState = eAsyncDone;
+  }
+  if(_asyncBlocking){
+    _asyncBlocking = false;
+    return;   // The result goes back to refreshMeasurementData()
+  }
+  if(0 == ret){
+    _asyncReady = true;
+  }
+  if(_measurementCallback){
+    _measurementCallback(this, ret);
+  }
+}
+
+void DFRobot_RS01::onTransportComplete(DFRobot_RS01Transport::sTransaction_t *t)
+{
+  DFRobot_RS01 *self = (DFRobot_RS01 *)t->context;
+  if(0 == t->ret){
+    self->decodeMeasurement();
+    self->onMeasurement();
+  }
+  self->finishAsync(t->ret);
+}
+
+void DFRobot_RS01::setResponseTimeout(uint32_t ms)
+{
+  if(_transport){
+    _transport->setTimeout(ms);
+  }else{
+    _DFRobot_RTU->setTimeoutTimeMs(ms);
+  }
+}
+
+uint16_t DFRobot_RS01::calculateCRC16(const uint8_t *pBuf, uint16_t len)
+{
+  uint16_t crc = 0xFFFF;
+  while(len--){
+    crc = updateCRC16(crc, *pBuf++);
+  }
+  return crc;
+}
+
+uint16_t DFRobot_RS01::updateCRC16(uint16_t crc, uint8_t c)
+{
+#if RS01_CRC_TABLE
+  return (crc >> 8) ^ pgm_read_word(&crc16Table[(crc ^ c) & 0xFF]);
+#else
+  crc ^= c;
+  for(uint8_t i = 0; i < 8; i++){
+    if(crc & 0x0001){
+      crc = (crc >> 1) ^ 0xA001;
+    }else{
+      crc >>= 1;
+    }
+  }
+  return crc;
+#endif
+}
+
+/***************** link failure handling ******************************/
+
+void DFRobot_RS01::setRetry(uint8_t retries, uint16_t jitterMs)
+{
+  _retries = (RS01_MAX_RETRIES < retries) ? RS01_MAX_RETRIES : retries;
+  _retryJitterMs = jitterMs;
+}
+
+void DFRobot_RS01::setAdaptiveTimeout(bool enable, uint8_t multiple)
+{
+  _adaptiveTimeout = enable;
+  _timeoutMultiple = multiple ? multiple : 1;
+  if(!enable && (_DFRobot_RTU || _transport)){
+    setResponseTimeout(_timeoutMs);   // Back to the fixed timeout
+  }
+}
+
+uint32_t DFRobot_RS01::getResponseTimeout(void)
+{
+  if(!_adaptiveTimeout || (RS01_ADAPTIVE_TIMEOUT_SAMPLES > _rttSamples)){
+    return _timeoutMs;
+  }
+  uint32_t ms = ((uint32_t)_timeoutMultiple * (_srttUs + 4 * _rttvarUs) + 999) / 1000;
+  if(ms < RS01_ADAPTIVE_TIMEOUT_MIN_MS){
+    ms = RS01_ADAPTIVE_TIMEOUT_MIN_MS;
+  }
+  for(uint8_t i = 0; (i < _rtoBackoff) && (ms < _timeoutMs); i++){
+    ms *= 2;   // RFC 6298 5.5: back off after each timeout, a slower sensor then answers within it again
+  }
+  return (ms < _timeoutMs) ? ms : _timeoutMs;
+}
+
+void DFRobot_RS01::setCircuitBreaker(uint8_t failures, uint32_t probeMs)
+{
+  _breakerFailures = failures;
+  _breakerProbeMs = probeMs;
+  _failureRun = 0;
+  _circuitState = eCircuitClosed;
+}
+
+DFRobot_RS01::eCircuitState_t DFRobot_RS01::getCircuitState(void)
+{
+  if((eCircuitOpen == _circuitState) && ((millis() - _circuitOpenMs) >= _breakerProbeMs)){
+    return eCircuitHalfOpen;
+  }
+  return _circuitState;
+}
+
+bool DFRobot_RS01::circuitAllows(bool write)
+{
+  if(eCircuitOpen != _circuitState){
+    return true;
+  }
+  if((millis() - _circuitOpenMs) >= _breakerProbeMs){
+    _circuitState = eCircuitHalfOpen;   // Let one probe through
+    return true;
+  }
+#if RS01_STATS
+  sOpStats_t *op = write ? &_stats.write : &_stats.read;
+  op->skipped++;
+#else
+  (void)write;
+#endif
+  return false;
+}
+
+void DFRobot_RS01::linkResult(uint8_t ret, uint32_t us)
+{
+  if((DFRobot_RTU::eRTU_RECV_ERROR == ret) || (DFRobot_RTU::eRTU_EXCEPTION_CRC_ERROR == ret)){
+    if(0xFF != _failureRun){
+      _failureRun++;
+    }
+    if((DFRobot_RTU::eRTU_RECV_ERROR == ret) && _adaptiveTimeout && (getResponseTimeout() < _timeoutMs)){
+      _rtoBackoff++;
+    }
+    if(_breakerFailures && ((eCircuitHalfOpen == _circuitState) || (_failureRun >= _breakerFailures))){
+      if(eCircuitOpen != _circuitState){
+        DBG("circuit open");
+      }
+      _circuitState = eCircuitOpen;
+      _circuitOpenMs = millis();
+    }
+    return;
+  }
+  if((DFRobot_RTU::eRTU_MEMORY_ERROR == ret) || (DFRobot_RTU::eRTU_ID_ERROR == ret)){
+    return;   // Local failures say nothing about the link
+  }
+
+  _failureRun = 0;   // The sensor answered, even a modbus exception proves the link
+  _rtoBackoff = 0;
+  _circuitState = eCircuitClosed;
+  if(0 != ret){
+    return;
+  }
+  if(0 == _rttSamples){   // First sample, RFC 6298: SRTT = R, RTTVAR = R / 2
+    _srttUs = us;
+    _rttvarUs = us / 2;
+  }else{
+    uint32_t err = (us > _srttUs) ? (us - _srttUs) : (_srttUs - us);
+    _rttvarUs = _rttvarUs - _rttvarUs / 4 + err / 4;
+    _srttUs = _srttUs - _srttUs / 8 + us / 8;
+  }
+  if(RS01_ADAPTIVE_TIMEOUT_SAMPLES > _rttSamples){
+    _rttSamples++;
+  }
+}
+
+bool DFRobot_RS01::retryAfter(bool write, uint8_t ret, uint8_t *attempt)
+{
+  if((DFRobot_RTU::eRTU_RECV_ERROR != ret) && (DFRobot_RTU::eRTU_EXCEPTION_CRC_ERROR != ret)){
+    return false;
+  }
+  if((eCircuitClosed != _circuitState) || (*attempt >= _retries)){
+    return false;   // A probe gets one attempt, and an open circuit refuses the rest anyway
+  }
+  (*attempt)++;
+#if RS01_STATS
+  sOpStats_t *op = write ? &_stats.write : &_stats.read;
+  op->retries++;
+#else
+  (void)write;
+#endif
+  if(_retryJitterMs){
+    delay(random(_retryJitterMs + 1));
+  }
+  return true;
+}
+
+void DFRobot_RS01::applyTimeout(void)
+{
+  if(_adaptiveTimeout && !_transport){   // A transport may be shared, its transactions carry the timeout instead
+    setResponseTimeout(getResponseTimeout());
+  }
+}
+
+uint32_t DFRobot_RS01::transactionTimeout(void)
+{
+  return _adaptiveTimeout ? getResponseTimeout() : 0;
+}
+
+/***************** transaction statistics ******************************/
+
+void DFRobot_RS01::getStats(sStats_t *stats)
+{
+#if RS01_STATS
+  *stats = _stats;
+  uint32_t count = _stats.read.transactions + _stats.write.transactions - _stats.read.timeouts - _stats.write.timeouts;
+  stats->avgUs = count ? (uint32_t)(_stats.totalUs / count) : 0;
+#else
+  memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void DFRobot_RS01::resetStats(void)
+{
+#if RS01_STATS
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.minUs = 0xFFFFFFFF;
+#endif
+}
+
+void DFRobot_RS01::recordTransaction(bool write, uint8_t ret, uint32_t us)
+{
+#if RS01_STATS
+  sOpStats_t *op = write ? &_stats.write : &_stats.read;
+  op->transactions++;
+  switch(ret){
+    case 0:
+      break;
+    case DFRobot_RTU::eRTU_EXCEPTION_CRC_ERROR:
+      op->crcErrors++;
+      break;
+    case DFRobot_RTU::eRTU_RECV_ERROR:
+      op->timeouts++;
+      return;   // The round trip is the timeout, it would only distort the times
+    case DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_FUNCTION:
+    case DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_ADDRESS:
+    case DFRobot_RTU::eRTU_EXCEPTION_ILLEGAL_DATA_VALUE:
+    case DFRobot_RTU::eRTU_EXCEPTION_SLAVE_FAILURE:
+      op->exceptions++;
+      break;
+    default:
+      op->otherErrors++;
+      break;
+  }
+
+  if(us < _stats.minUs){
+    _stats.minUs = us;
+  }
+  if(us > _stats.maxUs){
+    _stats.maxUs = us;
+  }
+  _stats.totalUs += us;
+
+  uint8_t bin = 0;
+  while((us >>= 1) && (bin < (RS01_STATS_BINS - 1))){
+    bin++;
+  }
+  if(0xFFFF != _stats.histogram[bin]){
+    _stats.histogram[bin]++;
+  }
+#else
+  (void)write;
+  (void)ret;
+  (void)us;
+#endif
+}
+
+/************ Modbus-RTU interface init and read/write ***********/
+
+uint8_t DFRobot_RS01::writeBroadcast(uint16_t reg, const uint16_t *pBuf, uint8_t size)
+{
+  if((NULL == _stream) || (RS01_BROADCAST_MAX_REGS < size)){
+    return DFRobot_RTU::eRTU_MEMORY_ERROR;
+  }
+
+  uint8_t frame[9 + 2 * RS01_BROADCAST_MAX_REGS];
+  uint8_t len = 0;
+  frame[len++] = RS01_BROADCAST_ADDR;
+  frame[len++] = 0x10;   // Write multiple holding registers
+  frame[len++] = (uint8_t)(reg >> 8);
+  frame[len++] = (uint8_t)(reg & 0xFF);
+  frame[len++] = 0x00;
+  frame[len++] = size;
+  frame[len++] = 2 * size;
+  for(uint8_t i = 0; i < size; i++){
+    frame[len++] = (uint8_t)(pBuf[i] >> 8);
+    frame[len++] = (uint8_t)(pBuf[i] & 0xFF);
+  }
+  uint16_t crc = calculateCRC16(frame, len);
+  frame[len++] = (uint8_t)(crc & 0xFF);
+  frame[len++] = (uint8_t)(crc >> 8);
+
+  _stream->write(frame, len);
+  _stream->flush();   // Return once the frame left, the slaves don't respond
+  return 0;
+}
+
+uint8_t DFRobot_RS01::exchange(bool write, uint16_t reg, uint16_t *pBuf, uint8_t size)
+{
+  if(_transport){
+    DFRobot_RS01Transport::sTransaction_t t = {(uint8_t)basicInfo.modbusAddr, (uint8_t)(write ? 0x10 : 0x03), reg, size, pBuf,
+                                               DFRobot_RS01Transport::eTransactionIdle, 0, NULL, NULL, NULL, transactionTimeout()};
+    return _transport->transfer(&t);
+  }
+  if(write){
+    return _DFRobot_RTU->writeHoldingRegister(basicInfo.modbusAddr, reg, pBuf, size);
+  }
+  return _DFRobot_RTU->readHoldingRegister(basicInfo.modbusAddr, reg, pBuf, size);
+}
+
+uint8_t DFRobot_RS01::transact(bool write, uint16_t reg, uint16_t *pBuf, uint8_t size)
+{
+  if(!circuitAllows(write)){
+    return DFRobot_RTU::eRTU_RECV_ERROR;   // Fail fast, the sensor is known to be unreachable
+  }
+
+  uint8_t ret;
+  uint8_t attempt = 0;
+  do{
+    applyTimeout();
+    uint32_t startUs = micros();
+    ret = exchange(write, reg, pBuf, size);
+    uint32_t us = micros() - startUs;
+    recordTransaction(write, ret, us);
+    linkResult(ret, us);
+  }while(retryAfter(write, ret, &attempt));
+  return ret;
+}
+
+uint8_t DFRobot_RS01::readData(uint16_t reg, uint16_t * pBuf, uint8_t size)
+{
+  if(NULL == pBuf)
+  {
+    DBG("pBuf ERROR!! : null pointer");
+  }
+  if(RS01_BROADCAST_ADDR == basicInfo.modbusAddr){
+    return DFRobot_RTU::eRTU_ID_ERROR;   // Nobody answers a broadcast read
+  }
+  uint8_t ret = transact(false, reg, pBuf, size);
+  if(ret){
+    DBG(ret);
+  }
+  // delay(100);
+  return ret;
+}
+
+uint8_t DFRobot_RS01::writeData(uint16_t reg, const void * pBuf, uint8_t size)
+{
+  if(NULL == pBuf)
+  {
+    DBG("pBuf ERROR!! : null pointer");
+  }
+
+  uint8_t ret;
+  if(RS01_BROADCAST_ADDR == basicInfo.modbusAddr){   // No response: nothing to time, retry or break on
+    uint32_t startUs = micros();
+    if(_transport){   // The transport knows not to wait for a response
+      ret = exchange(true, reg, (uint16_t *)pBuf, size);
+    }else{
+      ret = writeBroadcast(reg, (const uint16_t *)pBuf, size);
+    }
+    recordTransaction(true, ret, micros() - startUs);
+  }else{
+    ret = transact(true, reg, (uint16_t *)pBuf, size);
+  }
   if(ret){
     DBG(ret);
   }
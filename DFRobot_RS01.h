@@ -15,6 +15,11 @@
 #include <Arduino.h>
 #include <Stream.h>
 #include <DFRobot_RTU.h>
+#include "DFRobot_RS01Transport.h"
+#if defined(ESP32)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
 
 // #define ENABLE_DBG   //!< Open the macro and you can see the details of the program
 #ifdef ENABLE_DBG
@@ -55,6 +60,69 @@
 #define RS01_COMPARISON_OFFSET             uint16_t(0x0016)   ///< comparison offset config register, the default value is 0x0000
 #define RS01_RESET_FACTORY                 uint16_t(0x0017)   ///< restore to factory setting
 
+/* Readiness probe timing used by begin() and waitReady() */
+#define RS01_READY_TIMEOUT_MS         1100   ///< longest time begin() waits for the sensor, the same as the former fixed delays
+#define RS01_READY_PROBE_TIMEOUT_MS   100    ///< response timeout of a single readiness probe
+#define RS01_READY_PROBE_MIN_MS       5      ///< interval after the first failed probe, doubled after every failure
+#define RS01_READY_PROBE_MAX_MS       200    ///< upper bound of the probe interval
+#define RS01_PID_MISMATCH             0xF0   ///< waitReady(): a device answered with another PID, apart from the DFRobot_RTU codes
+
+/* Bytes on the wire used by the adaptive measurement read cost model */
+#define RS01_FRAME_OVERHEAD_BYTES     17     ///< read request(8) + response header and CRC(5) + 3.5 character silence(4)
+
+/* Broadcast configuration */
+#define RS01_BROADCAST_ADDR           0x00   ///< every slave on the bus processes a write to this address and none responds
+#define RS01_BROADCAST_MAX_REGS       11     ///< longest broadcast write in registers
+#define RS01_BROADCAST_SETTLE_MS      10     ///< pause after a broadcast write before reading it back, the slaves are still applying it
+
+/* Persisted configuration snapshot, see getSnapshot() */
+#define RS01_SNAPSHOT_MAGIC           uint16_t(0x5301)   ///< marks a snapshot, change it with the layout of sSnapshot_t
+
+/* Bulk read of the whole register map by refreshAll() */
+#define RS01_ALL_REGS                 23     ///< RS01_PID_REG~RS01_COMPARISON_OFFSET: basic information(6), measured data(11), measurement parameters(6)
+
+/* Register bits of the configuration cache */
+#define RS01_REG_BIT(reg)              (1UL << (reg))
+#define RS01_BASIC_INFO_MASK           uint32_t(0x0000003F)   ///< registers 0x0000~0x0005
+#define RS01_MEASUREMENT_CONFIG_MASK   uint32_t(0x007E0000)   ///< registers 0x0011~0x0016
+
+/* Link verification used by negotiateBaudrate() */
+#define RS01_NEGOTIATE_BURST          20     ///< PID reads verifying a baud rate
+#define RS01_NEGOTIATE_MAX_ERRORS     0      ///< failed reads a baud rate may have and still pass
+
+/* Link failure handling of readData()/writeData(), see setRetry(), setAdaptiveTimeout() and setCircuitBreaker() */
+#define RS01_MAX_RETRIES              5      ///< upper bound of the retry count
+#define RS01_RETRY_JITTER_MS          5      ///< default upper bound of the random pause before a retry
+#define RS01_ADAPTIVE_TIMEOUT_MULTIPLE  3    ///< default multiple of the round-trip bound used as the adaptive timeout
+#define RS01_ADAPTIVE_TIMEOUT_MIN_MS  5      ///< the adaptive timeout never goes below this
+#define RS01_ADAPTIVE_TIMEOUT_SAMPLES 8      ///< good round trips needed before the adaptive timeout replaces the fixed one
+#define RS01_BREAKER_PROBE_MS         1000   ///< default time an open circuit breaker waits before letting a probe through
+
+/* Fixed-rate sampling, see setSampleRate() */
+#define RS01_SAMPLE_MAX_CATCHUP       3      ///< missed deadlines eSampleCatchUp still reads back to back, older ones are dropped
+
+#ifndef RS01_STATS
+  #define RS01_STATS                  1      ///< 1: transaction statistics(about 120 bytes per instance), 0: none, getStats() reports zeros; set it for the whole build
+#endif
+#ifndef RS01_STATS_BINS
+  #define RS01_STATS_BINS             20     ///< log2 round-trip histogram bins, bin n counts 2^n~2^(n+1)-1 us, the last one everything above
+#endif
+
+#ifndef RS01_CRC_TABLE
+  #define RS01_CRC_TABLE              1      ///< 1: 512-byte CRC16 lookup table in flash, 0: bitwise CRC16 for the smallest flash footprint
+#endif
+
+#if defined(ESP32)
+  #ifndef RS01_TASK_STACK_SIZE
+    #define RS01_TASK_STACK_SIZE      3072   ///< stack of the background acquisition task in bytes
+  #endif
+  #ifndef RS01_TASK_PRIORITY
+    #define RS01_TASK_PRIORITY        2      ///< priority of the background acquisition task
+  #endif
+#endif
+
+class DFRobot_RS01Stage;
+
 class DFRobot_RS01
 {
 public:
@@ -90,6 +158,71 @@ public:
     int16_t comparisonOffset;   /**< current comparison offset set value */
   }sMeasurementConfig_t;
 
+  /**
+   * @struct sSnapshot_t
+   * @brief Known-good sensor state to keep in EEPROM, NVS, flash or RTC memory, see getSnapshot() and setSnapshot()
+   */
+  typedef struct
+  {
+    uint16_t magic;   /**< RS01_SNAPSHOT_MAGIC */
+    sBasicInfo_t basicInfo;   /**< PID, VID, address, baud rate, check/stop bit and firmware version */
+    sMeasurementConfig_t measurementConfig;   /**< the six measurement parameters */
+    uint16_t crc;   /**< modbus CRC16 of the members above, catches a blank or worn storage */
+  }sSnapshot_t;
+
+  /**
+   * @struct sMeasurement_t
+   * @brief The measured data of one frame, distances and intensities in separate arrays so scans run over contiguous memory
+   */
+  typedef struct
+  {
+    uint8_t targetCount;   /**< the number of objects detected, 0~5 */
+    uint16_t distance[5];   /**< measured distance to objects 1~5, 0 for the objects not detected or not read */
+    uint16_t intensity[5];   /**< measured intensity of objects 1~5, 0 for the objects not detected or not read */
+  }sMeasurement_t;
+
+  /**
+   * @struct sSample_t
+   * @brief One timestamped measurement, with the distances and intensities split out of dataBuf
+   */
+  typedef struct
+  {
+    uint32_t timestamp;   /**< micros() when the frame was received */
+    uint8_t targetCount;   /**< the number of objects detected, 0~5 */
+    uint16_t distance[5];   /**< measured distance to objects 1~5 */
+    uint16_t intensity[5];   /**< measured intensity of objects 1~5 */
+  }sSample_t;
+
+  /**
+   * @struct sOpStats_t
+   * @brief Counters of one kind of modbus transaction
+   */
+  typedef struct
+  {
+    uint32_t transactions;   /**< transactions started */
+    uint32_t crcErrors;   /**< responses failing the CRC check(eRTU_EXCEPTION_CRC_ERROR) */
+    uint32_t timeouts;   /**< missing or broken responses(eRTU_RECV_ERROR), not part of the round-trip times */
+    uint32_t exceptions;   /**< modbus exception responses(codes 1~4) */
+    uint32_t otherErrors;   /**< any other failure(eRTU_MEMORY_ERROR, eRTU_ID_ERROR) */
+    uint32_t retries;   /**< attempts repeated after a timeout or CRC error, included in transactions */
+    uint32_t skipped;   /**< transactions refused without bus traffic while the circuit breaker was open */
+  }sOpStats_t;
+
+  /**
+   * @struct sStats_t
+   * @brief Transaction statistics, see getStats()
+   */
+  typedef struct
+  {
+    sOpStats_t read;   /**< register reads, blocking and non-blocking */
+    sOpStats_t write;   /**< register writes */
+    uint32_t minUs;   /**< shortest answered round trip in us */
+    uint32_t maxUs;   /**< longest answered round trip in us */
+    uint32_t avgUs;   /**< mean answered round trip in us, computed by getStats() */
+    uint64_t totalUs;   /**< sum of the answered round trips in us */
+    uint16_t histogram[RS01_STATS_BINS];   /**< log2 histogram of the answered round trips, saturates at 0xFFFF */
+  }sStats_t;
+
   /**
    * @enum  eBaudrateMode_t
    * @brief Available baud rate for the module
@@ -128,18 +261,136 @@ public:
     eStopBit2 = 0x0003,
   }eStopBitMode_t;
 
+  /**
+   * @enum  eAsyncState_t
+   * @brief State of the non-blocking measurement read
+   */
+  typedef enum
+  {
+    eAsyncIdle = 0,   /**< no request in flight */
+    eAsyncWaitResponse,   /**< request sent, the response frame is being collected by poll() */
+    eAsyncDone,   /**< a fresh, CRC-checked frame has been stored into dataBuf */
+    eAsyncError,   /**< the last request failed, see getAsyncError() */
+  }eAsyncState_t;
+
+  /**
+   * @enum  eCircuitState_t
+   * @brief State of the circuit breaker, see setCircuitBreaker()
+   */
+  typedef enum
+  {
+    eCircuitClosed = 0,   /**< transactions go to the bus */
+    eCircuitOpen,   /**< the sensor stopped answering, transactions fail at once */
+    eCircuitHalfOpen,   /**< the probe time is over, the next transaction decides whether the circuit closes */
+  }eCircuitState_t;
+
+  /**
+   * @enum  eWaitMode_t
+   * @brief How begin() and the configuration setters wait for the sensor
+   */
+  typedef enum
+  {
+    eWaitReady = 0,   /**< begin() probes the PID register with exponential backoff, setters return as soon as the write is acknowledged */
+    eWaitFixedDelay,   /**< the original fixed delays: 1.1s in begin(), 100ms after each setter */
+  }eWaitMode_t;
+
+  /**
+   * @enum  eNegotiateResult_t
+   * @brief Result of negotiateBaudrate()
+   */
+  typedef enum
+  {
+    eNegotiateOk = 0,   /**< the link runs at the fastest rate that passed the verification */
+    eNegotiateRestartNeeded,   /**< a new rate has been written, restart the sensor and call negotiateBaudrate() again */
+    eNegotiateNoSensor,   /**< the sensor didn't answer at any rate */
+  }eNegotiateResult_t;
+
+  /**
+   * @enum  eChange_t
+   * @brief Result of pollForChange()
+   */
+  typedef enum
+  {
+    eChangeNotDue = 0,   /**< the poll interval hasn't elapsed, the bus wasn't touched */
+    eChangeNone,   /**< a frame was read, it is within the deadbands of the last published one */
+    eChangeUpdated,   /**< a frame was read and differs meaningfully, it is now the published one */
+    eChangeError,   /**< the read failed */
+  }eChange_t;
+
+  /**
+   * @enum  eSamplePolicy_t
+   * @brief What service() does with deadlines that passed while a read was late or in flight
+   */
+  typedef enum
+  {
+    eSampleDrop = 0,   /**< skip them, the next read goes to the next deadline still ahead */
+    eSampleCatchUp,   /**< read for each of them back to back, up to RS01_SAMPLE_MAX_CATCHUP, so the sample count stays on rate */
+  }eSamplePolicy_t;
+
+  /**
+   * @enum  eSample_t
+   * @brief Result of service()
+   */
+  typedef enum
+  {
+    eSampleNotDue = 0,   /**< the next deadline is ahead, or sampling is off */
+    eSamplePending,   /**< a read was issued at its deadline and is waiting for the response */
+    eSampleReady,   /**< the read finished, measurement holds the new frame */
+    eSampleError,   /**< the read failed */
+  }eSample_t;
+
+  /**
+   * @struct sSampleStats_t
+   * @brief Timing quality of the fixed-rate sampling, see getSampleStats()
+   * @n     Intervals are measured between the times consecutive reads were issued
+   */
+  typedef struct
+  {
+    uint32_t samples;   /**< reads issued */
+    uint32_t dropped;   /**< deadlines skipped without a read */
+    uint32_t errors;   /**< reads that failed */
+    uint32_t lastIntervalUs;   /**< interval before the last read */
+    uint32_t minIntervalUs;   /**< shortest interval */
+    uint32_t maxIntervalUs;   /**< longest interval */
+    uint32_t avgIntervalUs;   /**< mean interval, computed by getSampleStats() */
+    uint32_t stddevUs;   /**< standard deviation of the intervals(jitter), computed by getSampleStats() */
+    uint32_t maxLatenessUs;   /**< longest delay between a deadline and its read */
+    int64_t sumDeviationUs;   /**< sum of interval - period */
+    uint64_t sumSquaredDeviationUs;   /**< sum of (interval - period)^2 */
+  }sSampleStats_t;
+
+  /**
+   * @brief Reopen the host serial port at a new baud rate, used by negotiateBaudrate()
+   * @param baudrate the baud rate in bit/s
+   */
+  typedef void (*hostBaudrate_t)(uint32_t baudrate);
+
+  /**
+   * @brief Restart the sensor(e.g. switch its supply off and on), used by negotiateBaudrate()
+   */
+  typedef void (*powerCycle_t)(void);
+
+  /**
+   * @brief Completion callback of the non-blocking measurement read
+   * @param sensor the sensor instance whose read completed
+   * @param ret 0 means dataBuf holds a fresh frame, otherwise the RTU exception code
+   */
+  typedef void (*measurementCallback_t)(DFRobot_RS01 *sensor, uint8_t ret);
+
 public:
   /**
    * @fn DFRobot_RS01
    * @brief constructor
-   * @param addr RS485 communication device address
+   * @param addr RS485 communication device address(1~247), or RS01_BROADCAST_ADDR(0x00):
+   * @n     then every write goes to all slaves in one frame without waiting for a response,
+   * @n     reads are refused with eRTU_ID_ERROR and setAllMeasurementParameters() starts from measurementConfig
    * @return None
    */
   DFRobot_RS01(uint8_t addr);
 
   /**
    * @fn begin
-   * @brief init function
+   * @brief init function, the modbus-RTU instance is embedded in the object: calling it again, e.g. in a retry loop, allocates nothing
    * @param _serial serial ports for communication, supporting hard and soft serial ports
    * @return int type, means returning initialization status
    * @retval 0 NO_ERROR
@@ -148,6 +399,91 @@ public:
    */
   int begin(Stream *_serial);
 
+  /**
+   * @fn begin
+   * @brief init function using a modbus-RTU instance provided by the caller, e.g. shared with other sensors on the same bus
+   * @param _serial serial port the RTU instance talks on, used by the non-blocking read
+   * @param rtu the RTU instance, it stays owned by the caller and must outlive the sensor
+   * @return int type, means returning initialization status
+   * @retval 0 NO_ERROR
+   * @retval -1 ERR_DATA_BUS
+   * @retval -2 ERR_IC_VERSION
+   */
+  int begin(Stream *_serial, DFRobot_RTU *rtu);
+
+  /**
+   * @fn begin
+   * @brief init function talking through a transport: DFRobot_RS01RTUTransport, DFRobot_RS01TCPTransport,
+   * @n     DFRobot_RS01IRQTransport or a custom one, the non-blocking read then submits to the transport
+   * @param transport the transport, it stays owned by the caller, several sensors may share it
+   * @return int type, means returning initialization status
+   * @retval 0 NO_ERROR
+   * @retval -1 ERR_DATA_BUS
+   * @retval -2 ERR_IC_VERSION
+   */
+  int begin(DFRobot_RS01Transport *transport);
+
+  /**
+   * @fn getTransport
+   * @brief Get the transport passed to begin()
+   * @return DFRobot_RS01Transport *, NULL when the sensor talks through a Stream/DFRobot_RTU
+   */
+  DFRobot_RS01Transport *getTransport(void);
+
+  /**
+   * @fn restart
+   * @brief Repeat the start-up of begin() on the link of the last begin(), e.g. after the sensor supply was switched back on
+   * @n     With a snapshot set(setSnapshot()) it restores the cache as begin() does
+   * @return int type, means returning initialization status, see begin()
+   */
+  int restart(void);
+
+  /**
+   * @fn setWaitMode
+   * @brief Select how begin() and the configuration setters wait for the sensor, call it before begin()
+   * @param mode eWaitReady(default) or eWaitFixedDelay, the latter for firmware that needs the settle time
+   * @return None
+   */
+  void setWaitMode(eWaitMode_t mode);
+
+  /**
+   * @fn waitReady
+   * @brief Probe the PID register until the sensor answers, the interval doubles after every failed probe
+   * @param timeoutMs the longest time to keep probing
+   * @return uint8_t, 0 means the sensor answered with the RS01 PID, RS01_PID_MISMATCH another PID,
+   * @n     otherwise the RTU exception code of the last probe
+   */
+  uint8_t waitReady(uint32_t timeoutMs);
+
+  /**
+   * @fn getSnapshot
+   * @brief Copy the cached basic information and measurement parameters into a snapshot to persist
+   * @n     Fill the cache first: refreshAll(), or refreshBasicInfo() and refreshMeasurementConfig()
+   * @param snapshot where to store it
+   * @return bool, false means the cache doesn't hold both blocks or staged writes are pending, nothing is stored
+   */
+  bool getSnapshot(sSnapshot_t *snapshot);
+
+  /**
+   * @fn setSnapshot
+   * @brief Fast start: let the next begin() trust a persisted snapshot, call it before begin()
+   * @n     The readiness probe then reads 0x0000~0x0005 instead of the PID alone, at no extra round trip. When PID, VID,
+   * @n     address, baud rate, check/stop bit and firmware version all match the snapshot, basicInfo and measurementConfig
+   * @n     are taken as cached and the refresh calls can be skipped; otherwise the snapshot is ignored, see isSnapshotRestored()
+   * @note Changes made to the measurement parameters by another master since the snapshot can't be detected
+   * @param snapshot the snapshot, copied: it may be a temporary. The copy serves every later begin()/restart() until
+   * @n     the next setSnapshot(), NULL disables the fast start
+   * @return None
+   */
+  void setSnapshot(const sSnapshot_t *snapshot);
+
+  /**
+   * @fn isSnapshotRestored
+   * @brief Check whether the last begin() restored the snapshot
+   * @return bool, false means the snapshot was missing, corrupt or stale: refresh and persist a new one
+   */
+  bool isSnapshotRestored(void);
+
   /**
    * @fn refreshBasicInfo
    * @brief Retrieve the basic information from the sensor and buffer it into the structure basicInfo that stores information
@@ -173,10 +509,272 @@ public:
    * @n      dataBuf[5]: measured distance to the third object; dataBuf[6]: measured intensity of the third object
    * @n      dataBuf[7]: measured distance to the fourth object; dataBuf[8]: measured intensity of the fourth object
    * @n      dataBuf[9]: measured distance to the fifth object; dataBuf[10]: measured intensity of the fifth object
+   * @n    The same data is split into measurement(sMeasurement_t): targetCount, distance[5] and intensity[5]
    * @return returning 0 means read succeeds
    */
   int refreshMeasurementData(void);
 
+  /**
+   * @fn refreshMeasurementData
+   * @brief Read only the part of the measured data that is needed, from RS01_TARGETS_NUMBER up to the last needed register
+   * @param maxTargets number of targets of interest, 0~5, 1 reads the nearest target only
+   * @param withIntensity false skips the intensity of the last target of interest
+   * @note The registers are interleaved, so the intensities in front of the last distance come in the same frame:
+   * @n    skipping one of them costs 2 bytes while a second transaction costs at least 13, a single read is always the cheapest.
+   * @n    The members of dataBuf that were not read are set to 0. dataBuf[0] keeps the count the sensor reported,
+   * @n    measurement.targetCount is limited to the targets read, so the stages only see real targets.
+   * @return returning 0 means read succeeds
+   */
+  int refreshMeasurementData(uint8_t maxTargets, bool withIntensity);
+
+  /**
+   * @fn measurementSpan
+   * @brief Get the number of registers from RS01_TARGETS_NUMBER a partial measurement read needs
+   * @param maxTargets number of targets of interest, 0~5
+   * @param withIntensity whether the intensity of the last target of interest is needed
+   * @return uint8_t, 1~11 registers
+   */
+  static uint8_t measurementSpan(uint8_t maxTargets, bool withIntensity);
+
+  /**
+   * @fn getReadTargets
+   * @brief Get the number of targets whose distance the last frame read, the slots behind them are zeros and not data
+   * @return uint8_t, 0~5, below 5 only after refreshMeasurementData(maxTargets, withIntensity)
+   */
+  uint8_t getReadTargets(void);
+
+  /**
+   * @fn setAdaptiveRead
+   * @brief Let refreshMeasurementData() pick the cheapest way to read the measured data
+   * @n     Two-phase: the target count with target 1 in one short frame, targets 2~n in a second frame only when they exist.
+   * @n     A running profile of the target counts decides per sample whether the single 11-register read is cheaper.
+   * @note In two-phase mode targets 2~n come from a later frame than the target count
+   * @param enable true to enable the adaptive read, false(default) always reads the 11 registers
+   * @return None
+   */
+  void setAdaptiveRead(bool enable);
+
+  /**
+   * @fn setZeroCopyRead
+   * @brief Let the full read of refreshMeasurementData() bypass DFRobot_RTU and parse the response in place
+   * @n     The frame is taken from the serial buffer in bulk, CRC-checked while it arrives and byte-swapped
+   * @n     straight into measurement and dataBuf in one pass, see startMeasurementRead()/poll()
+   * @note readData() isn't involved, so a subclass overriding it doesn't see these reads.
+   * @n    Ignored while a non-blocking read started by the user is pending, and by the adaptive two-phase read.
+   * @param enable true to enable the fast path, false(default) reads through DFRobot_RTU
+   * @return None
+   */
+  void setZeroCopyRead(bool enable);
+
+  /**
+   * @fn getSample
+   * @brief Copy the last measured data with its timestamp into a sample record, e.g. to push it into DFRobot_RS01SampleRing
+   * @param sample the record to fill
+   * @return None
+   */
+  void getSample(sSample_t *sample);
+
+  /**
+   * @fn getSampleTimestamp
+   * @brief Get the time the last measured data was received
+   * @return uint32_t, micros() when the frame in dataBuf was received
+   */
+  uint32_t getSampleTimestamp(void);
+
+  /**
+   * @fn nearestTarget
+   * @brief Find the nearest target of the last frame whose intensity reaches a threshold
+   * @param minIntensity the intensity threshold
+   * @return int8_t, the index of the target in measurement, 0~4, -1 if no target qualifies
+   */
+  int8_t nearestTarget(uint16_t minIntensity);
+
+  /**
+   * @fn setStage
+   * @brief Attach a processing stage(e.g. DFRobot_RS01Filter) run on every fresh measurement before it is handed out
+   * @n     Further stages are chained with DFRobot_RS01Stage::setNext()
+   * @param stage the first stage, NULL detaches the chain
+   * @return None
+   */
+  void setStage(DFRobot_RS01Stage *stage);
+
+/***************** change detection ******************************/
+
+  /**
+   * @fn pollForChange
+   * @brief Read the measured data when the poll interval has elapsed and report whether it changed meaningfully
+   * @n     Against the last published frame: the target count changed, or a distance/intensity moved past its deadband.
+   * @n     A static scene doubles the interval per unchanged frame up to the maximum, a change drops it back to the minimum.
+   * @param ret if not NULL, receives the result of refreshMeasurementData() when a read was made
+   * @return eChange_t, eChangeUpdated means measurement holds a new frame worth forwarding
+   */
+  eChange_t pollForChange(int *ret = NULL);
+
+  /**
+   * @fn setChangeDeadband
+   * @brief Set the changes pollForChange() treats as noise
+   * @param distance largest distance change of any target still ignored, 0(default) reports every change
+   * @param intensity largest intensity change of any target still ignored, 0xFFFF ignores the intensities
+   * @return None
+   */
+  void setChangeDeadband(uint16_t distance, uint16_t intensity);
+
+  /**
+   * @fn setPollInterval
+   * @brief Set the range the adaptive interval of pollForChange() moves in
+   * @param minMs interval while the scene changes, 0(default) reads at every call
+   * @param maxMs longest interval in a static scene, equal to minMs for a fixed interval
+   * @return None
+   */
+  void setPollInterval(uint32_t minMs, uint32_t maxMs);
+
+  /**
+   * @fn getPollInterval
+   * @brief Get the current interval of pollForChange()
+   * @return uint32_t, the interval in ms
+   */
+  uint32_t getPollInterval(void);
+
+/***************** fixed-rate sampling ******************************/
+
+  /**
+   * @fn setSampleRate
+   * @brief Issue non-blocking measurement reads on absolute micros() deadlines, driven by service()
+   * @n     Deadlines are period apart from the first one, work in loop() delays single reads but doesn't make the rate drift
+   * @param hz sample rate, 0 stops sampling
+   * @param policy what to do with deadlines missed while loop() was busy or a response was slow
+   * @return None
+   */
+  void setSampleRate(uint16_t hz, eSamplePolicy_t policy = eSampleDrop);
+
+  /**
+   * @fn service
+   * @brief Drive the fixed-rate sampling, call it as often as possible from loop()
+   * @n     It starts the read once its deadline passed and collects the response through poll(), it never blocks
+   * @param ret where to store the RTU exception code of a failed read, may be NULL
+   * @return eSample_t, eSampleReady means measurement holds a new frame
+   */
+  eSample_t service(int *ret = NULL);
+
+  /**
+   * @fn getSampleStats
+   * @brief Get the sample-interval jitter since setSampleRate() or the last resetSampleStats()
+   * @param stats where to copy the statistics
+   * @return None
+   */
+  void getSampleStats(sSampleStats_t *stats);
+
+  /**
+   * @fn resetSampleStats
+   * @brief Clear the sample-interval statistics
+   * @return None
+   */
+  void resetSampleStats(void);
+
+/***************** link failure handling ******************************/
+
+  /**
+   * @fn setRetry
+   * @brief Repeat register reads and writes that end in a timeout or CRC error
+   * @n     Modbus exception responses aren't repeated, the sensor answered and would answer the same
+   * @note A write whose response was lost may have taken effect already, the configuration registers
+   * @n    hold values so the repeat is harmless, except after an address or baud rate change
+   * @param retries extra attempts, 0~RS01_MAX_RETRIES, 0 by default
+   * @param jitterMs a random pause of 0~jitterMs ms precedes every retry, so that sensors failing together don't retry in step
+   * @return None
+   */
+  void setRetry(uint8_t retries, uint16_t jitterMs = RS01_RETRY_JITTER_MS);
+
+  /**
+   * @fn setAdaptiveTimeout
+   * @brief Derive the response timeout from the round trips of this sensor instead of the fixed 500ms
+   * @n     The round-trip bound is smoothed mean + 4 * mean deviation of the good round trips(as the TCP
+   * @n     retransmission timeout), the timeout is multiple times that, between RS01_ADAPTIVE_TIMEOUT_MIN_MS and 500ms.
+   * @n     Each timeout doubles it until the next answer(RFC 6298 backoff). Behind a transport the timeout goes with
+   * @n     each transaction, so sensors sharing the transport keep their own
+   * @param enable true: adapt after RS01_ADAPTIVE_TIMEOUT_SAMPLES good round trips, false: back to 500ms
+   * @param multiple timeout / round-trip bound
+   * @return None
+   */
+  void setAdaptiveTimeout(bool enable, uint8_t multiple = RS01_ADAPTIVE_TIMEOUT_MULTIPLE);
+
+  /**
+   * @fn getResponseTimeout
+   * @brief Get the response timeout used by the next transaction
+   * @return uint32_t, timeout in ms
+   */
+  uint32_t getResponseTimeout(void);
+
+  /**
+   * @fn setCircuitBreaker
+   * @brief Stop talking to a sensor after consecutive failures, so that a dead node can't stall the bus
+   * @n     After failures timeouts or CRC errors in a row, transactions fail at once with eRTU_RECV_ERROR
+   * @n     until probeMs passed; then one transaction goes through as a probe, without retries:
+   * @n     an answer closes the circuit, a failure opens it for another probeMs
+   * @param failures consecutive failures opening the circuit, 0 disables the breaker(default)
+   * @param probeMs time between two probes in ms
+   * @return None
+   */
+  void setCircuitBreaker(uint8_t failures, uint32_t probeMs = RS01_BREAKER_PROBE_MS);
+
+  /**
+   * @fn getCircuitState
+   * @brief Get the state of the circuit breaker
+   * @return eCircuitState_t, eCircuitHalfOpen once an open circuit is due for a probe
+   */
+  eCircuitState_t getCircuitState(void);
+
+/***************** transaction statistics ******************************/
+
+  /**
+   * @fn getStats
+   * @brief Get the counters and round-trip times of every transaction since construction or the last resetStats()
+   * @n     Timed-out transactions are only counted, their round trip is the response timeout and isn't part of the times
+   * @param stats where to copy the statistics, all zero when built with RS01_STATS 0
+   * @return None
+   */
+  void getStats(sStats_t *stats);
+
+  /**
+   * @fn resetStats
+   * @brief Clear the transaction statistics
+   * @return None
+   */
+  void resetStats(void);
+
+#if defined(ESP32)
+/***************** background acquisition(ESP32 only) ******************************/
+
+  /**
+   * @fn startBackgroundAcquisition
+   * @brief Read the measured data from a task pinned to a core, at a fixed period
+   * @n     Every frame is published through a seqlock, readSnapshot() gets a consistent copy from any core without a mutex
+   * @note While the task runs it owns the serial traffic of this sensor: don't call the other read/write functions,
+   * @n    and use readSnapshot() instead of dataBuf, which the task overwrites
+   * @param periodMs read period in ms
+   * @param core the core the task is pinned to, 0 or 1
+   * @return returning 0 means the task is running
+   * @retval 9 or eRTU_RECV_ERROR: the task is already running or begin() hasn't succeeded
+   * @retval 10 or eRTU_MEMORY_ERROR: the task couldn't be created
+   */
+  int startBackgroundAcquisition(uint32_t periodMs, uint8_t core);
+
+  /**
+   * @fn stopBackgroundAcquisition
+   * @brief Ask the background task to stop, it exits after the transaction in progress
+   * @return None
+   */
+  void stopBackgroundAcquisition(void);
+
+  /**
+   * @fn readSnapshot
+   * @brief Get a consistent copy of the last frame published by the background task, never blocks on the writer
+   * @param sample where to copy the frame and its timestamp
+   * @return true means a frame was copied, false means none has been published yet
+   */
+  bool readSnapshot(sSample_t *sample);
+#endif
+
   /**
    * @fn refreshMeasurementConfig
    * @brief Retrieve the currently configured parameters from the sensor and buffer it into the structure measurementConfig that stores information
@@ -191,13 +789,24 @@ public:
    */
   int refreshMeasurementConfig(void);
 
+  /**
+   * @fn refreshAll
+   * @brief Read every register from RS01_PID_REG to RS01_COMPARISON_OFFSET in one transaction and scatter them
+   * @n     into basicInfo, dataBuf/measurement and measurementConfig, as the three refresh functions would
+   * @n     One round trip instead of three, and the measured data and the configuration come from the same instant.
+   * @n     A sensor rejecting the long read(illegal data address or value) is read with the three separate reads instead.
+   * @return returning 0 means read succeeds
+   */
+  int refreshAll(void);
+
   /**
    * @fn setADDR
    * @brief Set the module communication address
    * @param addr Device address to be set, (1~247 is 0x0001~0x00F7)
-   * @return None
+   * @n     An address out of range returns eRTU_EXCEPTION_ILLEGAL_DATA_VALUE without writing
+   * @return uint8_t, 0 means the write is acknowledged, otherwise the same codes as writeData()
    */
-  void setADDR(uint16_t addr);
+  uint8_t setADDR(uint16_t addr);
 
   /**
    * @fn setBaudrateMode
@@ -206,9 +815,32 @@ public:
    * @n       eBaudrate2400---2400, eBaudrate4800---4800, eBaudrate9600---9600, 
    * @n       eBaudrate14400---14400, eBaudrate19200---19200, eBaudrate38400---38400, 
    * @n       eBaudrate57600---57600, eBaudrate115200---115200, eBaudrate_1000000---1000000
-   * @return None
+   * @return uint8_t, 0 means the write is acknowledged, otherwise the same codes as writeData()
+   */
+  uint8_t setBaudrateMode(eBaudrateMode_t mode);
+
+  /**
+   * @fn negotiateBaudrate
+   * @brief Find the current baud rate of the sensor, then move the link to the fastest rate that stays reliable
+   * @n     Every candidate is verified with a burst of RS01_NEGOTIATE_BURST PID reads, a failing one is rolled back.
+   * @n     Without powerCycle the sensor can't be restarted here: the next higher rate is written and
+   * @n     eNegotiateRestartNeeded returned, restart the sensor and call again until eNegotiateOk.
+   * @n     A rate that failed its verification becomes the ceiling: later calls on this instance settle below it
+   * @param hostBaudrate reopens the host serial port at the given rate
+   * @param powerCycle restarts the sensor, NULL if the caller restarts it
+   * @param maxMode the fastest rate to try
+   * @return eNegotiateResult_t, basicInfo.baudrate holds the rate the sensor runs at(or will after the restart)
+   */
+  eNegotiateResult_t negotiateBaudrate(hostBaudrate_t hostBaudrate, powerCycle_t powerCycle = NULL,
+                                       eBaudrateMode_t maxMode = eBaudrate_1000000);
+
+  /**
+   * @fn baudrateOf
+   * @brief Convert a baud rate mode to bit/s
+   * @param mode the baud rate mode
+   * @return uint32_t, the baud rate in bit/s, 0 for an unknown mode
    */
-  void setBaudrateMode(eBaudrateMode_t mode);
+  static uint32_t baudrateOf(eBaudrateMode_t mode);
 
   /**
    * @fn setCheckbitStopbit
@@ -221,9 +853,10 @@ public:
    * @n       stop bit:
    * @n             eStopBit1
    * @n             eStopBit2
-   * @return None
+   * @return uint8_t, 0 means the write is acknowledged, eRTU_EXCEPTION_ILLEGAL_DATA_VALUE for any other combination,
+   * @n      otherwise the same codes as writeData()
    */
-  void setCheckbitStopbit(uint16_t mode);
+  uint8_t setCheckbitStopbit(uint16_t mode);
 
   /**
    * @fn setAllMeasurementParameters
@@ -236,18 +869,248 @@ public:
    * @param endThreshold end threshold, 100~10000(0x0064~0x2710)
    * @param moduleSensitivity module sensitivity, 0x0000~0x0004
    * @param comparisonOffset comparison offset, -32768~32767(0~0xFFFF)
-   * @return None
+   * @note The current parameters are read back first, a failed read returns its code without writing
+   * @return uint8_t, 0 means the write is acknowledged, otherwise the same codes as writeData()
    */
-  void setAllMeasurementParameters(uint16_t startingPosition, uint16_t stopPosition,
-                                   uint16_t initialThreshold, uint16_t endThreshold,
-                                   uint16_t moduleSensitivity, uint16_t comparisonOffset);
+  uint8_t setAllMeasurementParameters(uint16_t startingPosition, uint16_t stopPosition,
+                                      uint16_t initialThreshold, uint16_t endThreshold,
+                                      uint16_t moduleSensitivity, uint16_t comparisonOffset);
 
   /**
    * @fn restoreFactorySetting
    * @brief Restore to factory setting
+   * @return uint8_t, 0 means the write is acknowledged, otherwise the same codes as writeData()
+   */
+  uint8_t restoreFactorySetting(void);
+
+  /**
+   * @fn setStartPosition
+   * @brief Configure the value at measurement start position, writes only this register
+   * @param value value at start position, 70~6600(0x0046~0x19C8), can't be greater than the cached stop position
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range, nothing is written
+   */
+  uint8_t setStartPosition(uint16_t value);
+
+  /**
+   * @fn setStopPosition
+   * @brief Configure the value at measurement stop position, writes only this register
+   * @param value value at stop position, 70~6600(0x0046~0x19C8), can't be less than the cached start position
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range, nothing is written
+   */
+  uint8_t setStopPosition(uint16_t value);
+
+  /**
+   * @fn setInitialThreshold
+   * @brief Configure the initial threshold, writes only this register
+   * @param value initial threshold, 100~10000(0x0064~0x2710), plus the cached comparison offset it must stay above 0
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range, nothing is written
+   */
+  uint8_t setInitialThreshold(uint16_t value);
+
+  /**
+   * @fn setEndThreshold
+   * @brief Configure the end threshold, writes only this register
+   * @param value end threshold, 100~10000(0x0064~0x2710), plus the cached comparison offset it must stay above 0
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range, nothing is written
+   */
+  uint8_t setEndThreshold(uint16_t value);
+
+  /**
+   * @fn setSensitivity
+   * @brief Configure the module sensitivity, writes only this register
+   * @param value module sensitivity, 0x0000~0x0004
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range, nothing is written
+   */
+  uint8_t setSensitivity(uint16_t value);
+
+  /**
+   * @fn setComparisonOffset
+   * @brief Configure the comparison offset, writes only this register
+   * @param value comparison offset, -32768~32767, both cached thresholds plus it must stay above 0
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range, nothing is written
+   */
+  uint8_t setComparisonOffset(int16_t value);
+
+  /**
+   * @fn setStartPosition
+   * @brief Compile-time checked variant, e.g. setStartPosition<500>(): the range is checked by static_assert,
+   * @n     the order against the stop position isn't checked at all
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   */
+  template<uint16_t value>
+  uint8_t setStartPosition(void)
+  {
+    static_assert((0x0046 <= value) && (0x19C8 >= value), "start position must be 0x0046~0x19C8");
+    return writeConfigRegister(MEASUREMENT_START_POSITION, value);
+  }
+
+  /**
+   * @fn setStopPosition
+   * @brief Compile-time checked variant, e.g. setStopPosition<1500>(): the range is checked by static_assert,
+   * @n     the order against the start position isn't checked at all
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   */
+  template<uint16_t value>
+  uint8_t setStopPosition(void)
+  {
+    static_assert((0x0046 <= value) && (0x19C8 >= value), "stop position must be 0x0046~0x19C8");
+    return writeConfigRegister(MEASUREMENT_END_POSITION, value);
+  }
+
+  /**
+   * @fn setInitialThreshold
+   * @brief Compile-time checked variant, e.g. setInitialThreshold<400>(): the range is checked by static_assert,
+   * @n     the sum with the comparison offset isn't checked at all
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   */
+  template<uint16_t value>
+  uint8_t setInitialThreshold(void)
+  {
+    static_assert((0x0064 <= value) && (0x2710 >= value), "initial threshold must be 0x0064~0x2710");
+    return writeConfigRegister(RS01_START_THRESHOLD, value);
+  }
+
+  /**
+   * @fn setEndThreshold
+   * @brief Compile-time checked variant, e.g. setEndThreshold<400>(): the range is checked by static_assert,
+   * @n     the sum with the comparison offset isn't checked at all
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   */
+  template<uint16_t value>
+  uint8_t setEndThreshold(void)
+  {
+    static_assert((0x0064 <= value) && (0x2710 >= value), "end threshold must be 0x0064~0x2710");
+    return writeConfigRegister(RS01_END_THRESHOLD, value);
+  }
+
+  /**
+   * @fn setSensitivity
+   * @brief Compile-time checked variant, e.g. setSensitivity<3>(): the range is checked by static_assert
+   * @return uint8_t, 0 means the write is acknowledged or the sensor already holds the value
+   */
+  template<uint16_t value>
+  uint8_t setSensitivity(void)
+  {
+    static_assert(0x0004 >= value, "module sensitivity must be 0x0000~0x0004");
+    return writeConfigRegister(RS01_MODULE_SENSITIVITY, value);
+  }
+
+/***************** configuration cache ******************************/
+
+  /**
+   * @fn stageConfig
+   * @brief Stage a new value of a writable register, nothing is sent until commit()
+   * @n     A value the cache already knows the sensor holds isn't marked dirty, so re-applying a config costs no traffic.
+   * @n     The cache is filled by refreshBasicInfo(), refreshMeasurementConfig() and every acknowledged write,
+   * @n     and trusted until invalidateConfigCache() or restoreFactorySetting(). A setter writing the register drops its staged value
+   * @param reg RS01_ADDR_REG, RS01_BAUDRATE_REG, RS01_CHECKBIT_STOPBIT_REG or MEASUREMENT_START_POSITION~RS01_COMPARISON_OFFSET
+   * @param value the new value, checked against the documented range of the register, the check/stop bit against
+   * @n     the combinations setCheckbitStopbit() accepts
+   * @return uint8_t, 0 means staged
+   * @retval 2 or eRTU_EXCEPTION_ILLEGAL_DATA_ADDRESS: the register isn't writable
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the value is out of range
+   */
+  uint8_t stageConfig(uint16_t reg, uint16_t value);
+
+  /**
+   * @fn commit
+   * @brief Write the staged registers that differ from the sensor, each run of neighbouring registers in one write
+   * @n     The measurement parameters go first, then baud rate and check/stop bit, the address last.
+   * @n     The staged measurement parameters merged with the cached ones must keep the rules of setAllMeasurementParameters():
+   * @n     start <= stop, initial and end threshold plus comparison offset above 0(checked where both values are known)
+   * @return uint8_t, 0 means every dirty register is written, otherwise the code of the failing write, whose registers stay dirty
+   * @retval 3 or eRTU_EXCEPTION_ILLEGAL_DATA_VALUE: the merged measurement parameters break a rule, nothing is written
+   */
+  uint8_t commit(void);
+
+  /**
+   * @fn invalidateConfigCache
+   * @brief Forget the cached configuration, e.g. after the sensor was reconfigured by someone else
+   * @return None
+   */
+  void invalidateConfigCache(void);
+
+/***************** non-blocking measurement read ******************************/
+
+  /**
+   * @fn startMeasurementRead
+   * @brief Send the 11-register measurement read request and return immediately, the response is collected by poll()
+   * @note Don't call the blocking functions of this instance while a request is in flight, they share the same serial port.
+   * @n    Without a transport the request is written straight to the Stream, outside the frame timing of DFRobot_RTU:
+   * @n    leave the 3.5 character silence after the previous frame on the line yourself
+   * @return returning 0 means the request has been sent
+   * @retval 9 or eRTU_RECV_ERROR: a request is already in flight or begin() hasn't succeeded
+   */
+  int startMeasurementRead(void);
+
+  /**
+   * @fn poll
+   * @brief Move the response parser along with the bytes currently available on the serial port, never blocks
+   * @n     When the frame is complete and CRC-checked it is stored into dataBuf, the ready flag is raised and the callback is invoked
+   * @return eAsyncState_t, the state after this call
+   */
+  eAsyncState_t poll(void);
+
+  /**
+   * @fn isMeasurementReady
+   * @brief Check whether a fresh frame arrived since the last call, the flag is cleared by reading it
+   * @return true means dataBuf holds a fresh frame
+   */
+  bool isMeasurementReady(void);
+
+  /**
+   * @fn getAsyncError
+   * @brief Get the exception code of the last non-blocking read
+   * @return uint8_t, 0 means success, otherwise the same codes as readData()
+   */
+  uint8_t getAsyncError(void);
+
+  /**
+   * @fn getAsyncState
+   * @brief Get the state of the non-blocking read without moving it along, unlike poll() nothing is read or serviced
+   * @return eAsyncState_t, the current state
+   */
+  eAsyncState_t getAsyncState(void);
+
+  /**
+   * @fn getAsyncDoneUs
+   * @brief Get the time the last non-blocking read completed or failed, to order completions across sensors
+   * @return uint32_t, micros() at the completion
+   */
+  uint32_t getAsyncDoneUs(void);
+
+  /**
+   * @fn setMeasurementCallback
+   * @brief Set the function called by poll() when a non-blocking read completes or fails
+   * @param callback completion callback, NULL to disable
    * @return None
    */
-  void restoreFactorySetting(void);
+  void setMeasurementCallback(measurementCallback_t callback);
+
+  /**
+   * @fn calculateCRC16
+   * @brief Calculate the modbus CRC16 of a frame
+   * @param pBuf frame data
+   * @param len frame length
+   * @return uint16_t, the CRC, low byte is sent first
+   */
+  static uint16_t calculateCRC16(const uint8_t *pBuf, uint16_t len);
+
+  /**
+   * @fn updateCRC16
+   * @brief Feed one more byte into a running modbus CRC16, start from 0xFFFF
+   * @n     Fed with a whole frame including its CRC the result is 0
+   * @param crc the running CRC
+   * @param c the byte
+   * @return uint16_t, the updated CRC
+   */
+  static uint16_t updateCRC16(uint16_t crc, uint8_t c);
 
 protected:
 
@@ -290,15 +1153,381 @@ protected:
    */
   virtual uint8_t writeData(uint16_t reg, const void * pBuf, uint8_t size);
 
+  /**
+   * @fn writeBroadcast
+   * @brief Send a write multiple holding registers frame to the broadcast address, no response is awaited
+   * @n     The frame is written straight to the Stream, outside the frame timing of DFRobot_RTU, whose read/write wait
+   * @n     for a response nobody sends; the caller leaves the 3.5 character silence after the previous frame
+   * @param reg  Register address 16bits
+   * @param pBuf Write data storage and buffer
+   * @param size Write data length, up to RS01_BROADCAST_MAX_REGS
+   * @return uint8_t, 0 means the frame has been sent, eRTU_MEMORY_ERROR if too long or begin() wasn't called
+   */
+  uint8_t writeBroadcast(uint16_t reg, const uint16_t *pBuf, uint8_t size);
+
 public:
   /* variable for storing the information obtained by users */
-  uint16_t dataBuf[11];   // the array storing the measured data
+  uint16_t dataBuf[11];   // the array storing the measured data, interleaved as in the registers
+  sMeasurement_t measurement;   // the measured data split by the frame decoder
   sBasicInfo_t basicInfo;   // the array storing the sensor basic information
   sMeasurementConfig_t measurementConfig;   // the array storing the sensor measurement parameters
 
 private:
+  /**
+   * @fn settle
+   * @brief Give the sensor its fixed settle time after a configuration access, only in eWaitFixedDelay mode
+   * @return None
+   */
+  void settle(void);
+
+#if defined(ESP32)
+  /**
+   * @fn acquisitionTask
+   * @brief Body of the background acquisition task
+   * @param arg the sensor instance
+   * @return None
+   */
+  static void acquisitionTask(void *arg);
+#endif
+
+  /**
+   * @fn recordTransaction
+   * @brief Add a finished transaction to the statistics
+   * @param write true for a register write, false for a read
+   * @param ret the RTU exception code of the transaction
+   * @param us round-trip time in us
+   * @return None
+   */
+  void recordTransaction(bool write, uint8_t ret, uint32_t us);
+
+  /**
+   * @fn exchange
+   * @brief One register read or write through the RTU instance or the transport, without retries
+   * @param write true for a register write, false for a read
+   * @param reg register address
+   * @param pBuf registers to write or storage for the read
+   * @param size number of registers
+   * @return uint8_t, 0 means success, otherwise the RTU exception code
+   */
+  uint8_t exchange(bool write, uint16_t reg, uint16_t *pBuf, uint8_t size);
+
+  /**
+   * @fn transact
+   * @brief exchange() behind the circuit breaker, with the adaptive timeout and the retries
+   * @param write true for a register write, false for a read
+   * @param reg register address
+   * @param pBuf registers to write or storage for the read
+   * @param size number of registers
+   * @return uint8_t, 0 means success, otherwise the RTU exception code
+   */
+  uint8_t transact(bool write, uint16_t reg, uint16_t *pBuf, uint8_t size);
+
+  /**
+   * @fn circuitAllows
+   * @brief Check the circuit breaker before a transaction, an open circuit due for a probe turns half-open
+   * @param write true for a register write, false for a read, a refused transaction counts as skipped
+   * @return true means the transaction may go to the bus
+   */
+  bool circuitAllows(bool write);
+
+  /**
+   * @fn linkResult
+   * @brief Feed the result of a transaction to the round-trip estimator and the circuit breaker
+   * @param ret the RTU exception code of the transaction
+   * @param us round-trip time in us
+   * @return None
+   */
+  void linkResult(uint8_t ret, uint32_t us);
+
+  /**
+   * @fn retryAfter
+   * @brief Decide whether a failed transaction is repeated, and wait the jitter pause when it is
+   * @param write true for a register write, false for a read
+   * @param ret the RTU exception code of the attempt
+   * @param attempt retries made so far, incremented when another one is due
+   * @return true means try again
+   */
+  bool retryAfter(bool write, uint8_t ret, uint8_t *attempt);
+
+  /**
+   * @fn applyTimeout
+   * @brief Hand the adaptive timeout to the RTU instance before a transaction, transport transactions carry their own
+   * @return None
+   */
+  void applyTimeout(void);
+
+  /**
+   * @fn transactionTimeout
+   * @brief Get the timeout a transport transaction of this sensor carries
+   * @return uint32_t, the adaptive timeout in ms, 0 for the timeout of the transport
+   */
+  uint32_t transactionTimeout(void);
+
+  /**
+   * @fn startup
+   * @brief Common part of the begin() functions: wait for the sensor and check its PID
+   * @return int, NO_ERROR, ERR_DATA_BUS or ERR_IC_VERSION
+   */
+  int startup(void);
+
+  /**
+   * @fn setResponseTimeout
+   * @brief Set the response timeout of whatever carries the frames, the RTU instance or the transport
+   * @param ms timeout in ms
+   * @return None
+   */
+  void setResponseTimeout(uint32_t ms);
+
+  /**
+   * @fn onTransportComplete
+   * @brief Completion of the non-blocking read submitted to a transport
+   * @param t the transaction, its context is the sensor
+   * @return None
+   */
+  static void onTransportComplete(DFRobot_RS01Transport::sTransaction_t *t);
+
+  /**
+   * @fn readMeasurementInPlace
+   * @brief Blocking full measurement read through the in-place parser of poll()
+   * @return int, 0 means read succeeds, otherwise the RTU exception code
+   */
+  int readMeasurementInPlace(void);
+
+  /**
+   * @fn decodeMeasurement
+   * @brief Split the interleaved registers in dataBuf into measurement
+   * @param readTargets targets whose distance dataBuf holds, see getReadTargets(); measurement.targetCount is limited to it
+   * @return None
+   */
+  void decodeMeasurement(uint8_t readTargets = 5);
+
+  /**
+   * @fn onMeasurement
+   * @brief Bookkeeping after every successful measurement read: timestamp, target count profile and processing stages
+   * @return None
+   */
+  void onMeasurement(void);
+
+  /**
+   * @fn changedSincePublished
+   * @brief Compare measurement with the last published frame using the deadbands
+   * @return true means the change is meaningful
+   */
+  bool changedSincePublished(void);
+
+  /**
+   * @fn writeConfigRegister
+   * @brief Write one configuration register unless the cache knows the sensor holds the value, and cache it
+   * @param reg register address
+   * @param value the value
+   * @return uint8_t, 0 means the write is acknowledged or skipped
+   */
+  uint8_t writeConfigRegister(uint16_t reg, uint16_t value);
+
+  /**
+   * @fn cacheHolds
+   * @brief Check whether the cache knows the sensor holds a value in a register
+   * @param reg register address
+   * @param value the value
+   * @return true means the write can be skipped
+   */
+  bool cacheHolds(uint16_t reg, uint16_t value);
+
+  /**
+   * @fn cacheWord
+   * @brief Get the word of basicInfo or measurementConfig mirroring a register
+   * @param reg register address, 0x0000~0x0005 or 0x0011~0x0016
+   * @return uint16_t pointer into the structure
+   */
+  uint16_t *cacheWord(uint16_t reg);
+
+  /**
+   * @fn stagedSlot
+   * @brief Get the index in _staged of a writable register
+   * @param reg register address
+   * @return uint8_t, 0~8
+   */
+  uint8_t stagedSlot(uint16_t reg);
+
+  /**
+   * @fn checkbitStopbitValid
+   * @brief Check a check bit/stop bit register value against the eCheckBitMode_t | eStopBitMode_t combinations
+   * @param mode the register value
+   * @return bool, true means the sensor supports it
+   */
+  static bool checkbitStopbitValid(uint16_t mode);
+
+  /**
+   * @fn stagedConfigValid
+   * @brief Check the cross-register rules on the staged measurement parameters merged with the cached ones
+   * @return bool, true means commit() may write them
+   */
+  bool stagedConfigValid(void);
+
+  /**
+   * @fn commitRange
+   * @brief Write the dirty registers between first and last, one write per run of neighbouring registers
+   * @param first first register address
+   * @param last last register address
+   * @return uint8_t, 0 means success, otherwise the code of the failing write
+   */
+  uint8_t commitRange(uint16_t first, uint16_t last);
+
+  /**
+   * @fn verifyLink
+   * @brief Read the PID register several times with the short probe timeout
+   * @param reads the number of reads
+   * @return uint8_t, the number of reads that failed or returned another PID
+   */
+  uint8_t verifyLink(uint8_t reads);
+
+  /**
+   * @fn negotiate
+   * @brief Body of negotiateBaudrate(), called again after every restart it does itself
+   * @param hostBaudrate reopens the host serial port at the given rate
+   * @param powerCycle restarts the sensor, NULL if the caller restarts it
+   * @param maxMode the fastest rate to try
+   * @param depth restarts so far, bounded in case a step down never takes
+   * @return eNegotiateResult_t
+   */
+  eNegotiateResult_t negotiate(hostBaudrate_t hostBaudrate, powerCycle_t powerCycle, eBaudrateMode_t maxMode, uint8_t depth);
+
+  /**
+   * @fn findBaudrate
+   * @brief Look for the baud rate the sensor currently answers at, the factory 115200 is tried first
+   * @param hostBaudrate reopens the host serial port at the given rate
+   * @return bool, true means found, basicInfo.baudrate and the host port are set to it
+   */
+  bool findBaudrate(hostBaudrate_t hostBaudrate);
+
+  /**
+   * @fn readIdentity
+   * @brief Read the PID, and the whole basic information when a snapshot is set, and check the PID
+   * @return uint8_t, 0 means the sensor answered with the RS01 PID, RS01_PID_MISMATCH another PID,
+   * @n     otherwise the RTU exception code
+   */
+  uint8_t readIdentity(void);
+
+  /**
+   * @fn restoreSnapshot
+   * @brief Take the measurement parameters of the snapshot when it matches the basic information just read
+   * @return bool, true means restored
+   */
+  bool restoreSnapshot(void);
+
+  /**
+   * @fn fullReadCheaper
+   * @brief Compare the expected bytes of the two-phase read with the single 11-register read using the target count profile
+   * @return true means the single 11-register read is expected to be cheaper
+   */
+  bool fullReadCheaper(void);
+
+  /**
+   * @fn profileTargets
+   * @brief Add a target count to the running profile, old counts fade out by halving
+   * @param count the target count of the last frame
+   * @return None
+   */
+  void profileTargets(uint16_t count);
+
+  /**
+   * @fn isqrt
+   * @brief Integer square root, getSampleStats() stays exact where double is a 32-bit float(AVR)
+   * @param value the radicand
+   * @return uint32_t, floor(sqrt(value))
+   */
+  static uint32_t isqrt(uint64_t value);
+
+  /**
+   * @fn finishAsync
+   * @brief Close the non-blocking read with the given result and notify the user
+   * @param ret 0 means success, otherwise the RTU exception code
+   * @return None
+   */
+  void finishAsync(uint8_t ret);
+
   /* private variables */
-  DFRobot_RTU *_DFRobot_RTU;   // the pointer to RS485 communication mode instance
+  DFRobot_RTU _rtu;   // RS485 communication mode instance owned by the sensor, no heap allocation
+  DFRobot_RTU *_DFRobot_RTU;   // the pointer to RS485 communication mode instance in use, _rtu or the one shared by the caller
+  Stream *_stream;   // the serial port passed to begin(), used by the non-blocking read
+  uint32_t _timeoutMs;   // response timeout in ms
+  eWaitMode_t _waitMode;   // how begin() and the setters wait for the sensor
+  bool _adaptiveRead;   // refreshMeasurementData() picks between the two-phase and the full read
+  uint8_t _targetProfile[6];   // running histogram of the target counts 0~5
+  uint8_t _readTargets;   // targets whose distance the last frame read
+  uint32_t _sampleUs;   // micros() when the frame in dataBuf was received
+#if RS01_STATS
+  sStats_t _stats;   // transaction statistics
+#endif
+
+  /* link failure handling */
+  uint8_t _retries;   // extra attempts after a timeout or CRC error
+  uint16_t _retryJitterMs;   // upper bound of the random pause before a retry
+  bool _adaptiveTimeout;   // the timeout follows the round-trip estimate
+  uint8_t _timeoutMultiple;   // adaptive timeout / round-trip bound
+  uint32_t _srttUs;   // smoothed round trip of the good transactions
+  uint32_t _rttvarUs;   // smoothed mean deviation of the round trip
+  uint8_t _rttSamples;   // good round trips seen, saturates at RS01_ADAPTIVE_TIMEOUT_SAMPLES
+  uint8_t _rtoBackoff;   // doublings of the adaptive timeout since the last answer
+  uint8_t _breakerFailures;   // consecutive failures opening the circuit, 0 when disabled
+  uint32_t _breakerProbeMs;   // time between two probes
+  uint8_t _failureRun;   // consecutive timeouts or CRC errors
+  uint8_t _baudrateCeiling;   // eBaudrateMode_t negotiateBaudrate() climbs to at most, lowered when a rate fails
+  eCircuitState_t _circuitState;   // state of the circuit breaker
+  uint32_t _circuitOpenMs;   // millis() when the circuit opened
+
+  /* configuration cache */
+  uint32_t _cacheValid;   // RS01_REG_BIT() of the registers whose value basicInfo/measurementConfig mirror
+  uint32_t _cacheDirty;   // RS01_REG_BIT() of the registers staged with a new value
+  uint16_t _staged[9];   // staged values: address, baud rate, check/stop bit, the 6 measurement parameters
+  sSnapshot_t _bootSnapshot;   // copy of the snapshot every begin()/restart() validates
+  bool _hasBootSnapshot;   // a snapshot was set
+  bool _snapshotRestored;   // the last begin() restored the snapshot
+
+#if defined(ESP32)
+  /* background acquisition state */
+  TaskHandle_t _taskHandle;   // the background task, NULL when not running
+  volatile bool _taskRun;   // cleared to ask the task to exit
+  uint32_t _taskPeriodMs;   // read period of the task
+  volatile uint32_t _snapSeq;   // seqlock sequence, odd while the snapshot is being written
+  sSample_t _snapshot;   // last frame published by the task
+#endif
+
+  /* non-blocking read state */
+  volatile eAsyncState_t _asyncState;   // state of the non-blocking read
+  volatile bool _asyncReady;   // a fresh frame arrived and hasn't been consumed
+  uint8_t _asyncError;   // exception code of the last non-blocking read
+  uint32_t _asyncStartMs;   // time the request was sent
+  uint32_t _asyncStartUs;   // time the request was sent, for the statistics
+  uint32_t _asyncDoneUs;   // time the last request completed or failed
+  uint8_t _rxLen;   // bytes collected into _rxBuf
+  uint8_t _rxExpected;   // length of the frame being collected, 0 until the header is known
+  uint8_t _rxBuf[5 + 2 * 11];   // response frame: addr, function, byte count, 11 registers, CRC
+  uint16_t _rxCrc;   // running CRC over the bytes collected, 0 once a complete frame checks out
+  bool _asyncBlocking;   // the pending read belongs to refreshMeasurementData(), don't report it as a non-blocking result
+  bool _zeroCopyRead;   // refreshMeasurementData() reads through the in-place parser
+  measurementCallback_t _measurementCallback;   // completion callback
+  DFRobot_RS01Stage *_stage;   // first processing stage, NULL when none
+  DFRobot_RS01Transport *_transport;   // transport carrying the frames, NULL when talking through _DFRobot_RTU
+  DFRobot_RS01Transport::sTransaction_t _asyncTransaction;   // non-blocking read submitted to the transport
+
+  /* change detection state */
+  sMeasurement_t _published;   // frame last reported as eChangeUpdated
+  bool _publishedValid;   // _published holds a frame
+  uint16_t _deadbandDistance;   // distance change ignored by pollForChange()
+  uint16_t _deadbandIntensity;   // intensity change ignored by pollForChange()
+  uint32_t _pollMinMs;   // interval while the scene changes
+  uint32_t _pollMaxMs;   // interval cap in a static scene
+  uint32_t _pollIntervalMs;   // current interval
+  uint32_t _lastPollMs;   // time of the last read made by pollForChange()
+
+  /* fixed-rate sampling state */
+  uint32_t _samplePeriodUs;   // deadline spacing, 0 while sampling is off
+  eSamplePolicy_t _samplePolicy;   // what to do with missed deadlines
+  uint32_t _sampleDeadlineUs;   // micros() of the next deadline
+  uint32_t _sampleIssueUs;   // micros() when the last read was issued
+  bool _sampleInFlight;   // the pending non-blocking read belongs to service()
+  sSampleStats_t _sampleStats;   // interval statistics
 };
 
 #endif
@@ -0,0 +1,171 @@
+/*!
+ * @file  DFRobot_RS01Bus.cpp
+ * @brief  Define the infrastructure DFRobot_RS01Bus class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01Bus.h"
+
+DFRobot_RS01Bus::DFRobot_RS01Bus(Stream *_serial, uint32_t baudrate)
+  : _stream(_serial), _rtu(_serial), _broadcast(RS01_BROADCAST_ADDR)
+{
+  _broadcast.begin(_serial, &_rtu);
+  _count = 0;
+  _totalWeight = 0;
+  _lastFrameUs = micros();
+  _sampleCallback = NULL;
+  setBaudrate(baudrate);
+}
+
+int DFRobot_RS01Bus::addSensor(DFRobot_RS01 *sensor, uint8_t weight)
+{
+  if((NULL == sensor) || (RS01_BUS_MAX_SENSORS <= _count)){
+    DBG("ERR_BUS_FULL");
+    return ERR_BUS_FULL;
+  }
+
+  waitInterFrame();
+  int ret = sensor->begin(_stream, &_rtu);
+  markFrameEnd();
+  if(NO_ERROR != ret){
+    return ret;
+  }
+
+  if(0 == weight){
+    weight = 1;
+  }
+  _slots[_count].sensor = sensor;
+  _slots[_count].weight = weight;
+  _slots[_count].current = 0;
+  _slots[_count].lastError = 0;
+  _totalWeight += weight;
+  return _count++;
+}
+
+int DFRobot_RS01Bus::poll(void)
+{
+  if(0 == _count){
+    return -1;
+  }
+
+  /* Smooth weighted round-robin: every slot earns its weight, the richest one is read and pays the total back */
+  uint8_t next = 0;
+  for(uint8_t i = 0; i < _count; i++){
+    _slots[i].current += _slots[i].weight;
+    if(_slots[i].current > _slots[next].current){
+      next = i;
+    }
+  }
+  _slots[next].current -= _totalWeight;
+
+  waitInterFrame();
+  uint8_t ret = _slots[next].sensor->refreshMeasurementData();
+  markFrameEnd();
+
+  _slots[next].lastError = ret;
+  if(_sampleCallback){
+    _sampleCallback(next, _slots[next].sensor, ret);
+  }
+  return next;
+}
+
+void DFRobot_RS01Bus::setBaudrate(uint32_t baudrate)
+{
+  if((0 == baudrate) || (19200 < baudrate)){
+    _interFrameUs = 1750;   // The modbus spec fixes the silence above 19200 baud
+  }else{
+    _interFrameUs = (38500000UL + baudrate - 1) / baudrate;   // 3.5 characters of 11 bits
+  }
+}
+
+uint32_t DFRobot_RS01Bus::getInterFrameUs(void)
+{
+  return _interFrameUs;
+}
+
+void DFRobot_RS01Bus::setSampleCallback(sampleCallback_t callback)
+{
+  _sampleCallback = callback;
+}
+
+uint8_t DFRobot_RS01Bus::getSensorCount(void)
+{
+  return _count;
+}
+
+DFRobot_RS01 *DFRobot_RS01Bus::getSensor(uint8_t index)
+{
+  if(index >= _count){
+    return NULL;
+  }
+  return _slots[index].sensor;
+}
+
+uint8_t DFRobot_RS01Bus::getLastError(uint8_t index)
+{
+  if(index >= _count){
+    return DFRobot_RTU::eRTU_ID_ERROR;
+  }
+  return _slots[index].lastError;
+}
+
+int DFRobot_RS01Bus::broadcastAllMeasurementParameters(uint16_t startingPosition, uint16_t stopPosition,
+                                                       uint16_t initialThreshold, uint16_t endThreshold,
+                                                       uint16_t moduleSensitivity, uint16_t comparisonOffset,
+                                                       bool verify)
+{
+  waitInterFrame();
+  uint8_t ret = _broadcast.setAllMeasurementParameters(startingPosition, stopPosition, initialThreshold,
+                                                       endThreshold, moduleSensitivity, comparisonOffset);
+  markFrameEnd();
+  for(uint8_t i = 0; i < _count; i++){
+    _slots[i].sensor->invalidateConfigCache();
+  }
+  if(ret){
+    return -1;
+  }
+  if(!verify){
+    return 0;
+  }
+
+  delay(RS01_BROADCAST_SETTLE_MS);   // Read back too soon, a sensor still applying the write times out or answers the old values
+  int failed = 0;
+  for(uint8_t i = 0; i < _count; i++){
+    DFRobot_RS01 *sensor = _slots[i].sensor;
+    waitInterFrame();
+    ret = sensor->refreshMeasurementConfig();
+    markFrameEnd();
+    if(ret || (0 != memcmp(&sensor->measurementConfig, &_broadcast.measurementConfig, sizeof(sensor->measurementConfig)))){
+      failed++;
+    }
+  }
+  return failed;
+}
+
+uint8_t DFRobot_RS01Bus::broadcastRestoreFactorySetting(void)
+{
+  waitInterFrame();
+  uint8_t ret = _broadcast.restoreFactorySetting();
+  markFrameEnd();
+  for(uint8_t i = 0; i < _count; i++){
+    _slots[i].sensor->invalidateConfigCache();
+  }
+  return ret;
+}
+
+void DFRobot_RS01Bus::waitInterFrame(void)
+{
+  uint32_t elapsed = micros() - _lastFrameUs;
+  if(elapsed < _interFrameUs){
+    delayMicroseconds(_interFrameUs - elapsed);
+  }
+}
+
+void DFRobot_RS01Bus::markFrameEnd(void)
+{
+  _lastFrameUs = micros();
+}
@@ -0,0 +1,172 @@
+/*!
+ * @file  DFRobot_RS01Bus.h
+ * @brief  Define infrastructure of DFRobot_RS01Bus class
+ * @details  Poll several RS01 sensors sharing one RS485 segment through a single modbus-RTU instance
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_BUS_H__
+#define __DFROBOT_RS01_BUS_H__
+
+#include "DFRobot_RS01.h"
+
+#ifndef RS01_BUS_MAX_SENSORS
+  #define RS01_BUS_MAX_SENSORS   16   ///< sensors one bus can hold, define it before including this file to change it
+#endif
+
+class DFRobot_RS01Bus
+{
+public:
+  /**
+   * @brief Called by poll() after every measurement read
+   * @param index index of the sensor returned by addSensor()
+   * @param sensor the sensor, its dataBuf holds the new frame when ret is 0
+   * @param ret 0 means read succeeds, otherwise the RTU exception code
+   */
+  typedef void (*sampleCallback_t)(uint8_t index, DFRobot_RS01 *sensor, uint8_t ret);
+
+  /**
+   * @fn DFRobot_RS01Bus
+   * @brief constructor
+   * @param _serial serial port of the RS485 segment, supporting hard and soft serial ports
+   * @param baudrate baud rate the serial port runs at, used for the modbus inter-frame silence
+   * @return None
+   */
+  DFRobot_RS01Bus(Stream *_serial, uint32_t baudrate);
+
+  /**
+   * @fn addSensor
+   * @brief Register a sensor on the bus, the sensor is initialized with the shared RTU instance
+   * @param sensor sensor constructed with its modbus address(1~247)
+   * @param weight share of the poll schedule, a sensor with weight 2 is read twice as often as one with weight 1
+   * @return int type, index of the sensor or the begin() error
+   * @retval >=0 index of the sensor
+   * @retval -1 ERR_DATA_BUS
+   * @retval -2 ERR_IC_VERSION
+   * @retval -3 ERR_BUS_FULL
+   */
+  int addSensor(DFRobot_RS01 *sensor, uint8_t weight = 1);
+
+  /**
+   * @fn poll
+   * @brief Read the measured data of the next sensor in the schedule
+   * @n     The modbus 3.5 character silence since the previous frame is kept before the request is sent
+   * @return int type, index of the sensor that was read, -1 if no sensor is registered
+   */
+  int poll(void);
+
+  /**
+   * @fn setBaudrate
+   * @brief Update the baud rate used for the inter-frame silence, call it after changing the serial port speed
+   * @param baudrate baud rate the serial port runs at
+   * @return None
+   */
+  void setBaudrate(uint32_t baudrate);
+
+  /**
+   * @fn getInterFrameUs
+   * @brief Get the silence kept between two frames
+   * @return uint32_t, 3.5 character times at the current baud rate, fixed to 1750us above 19200
+   */
+  uint32_t getInterFrameUs(void);
+
+  /**
+   * @fn setSampleCallback
+   * @brief Set the function called by poll() after every measurement read
+   * @param callback sample callback, NULL to disable
+   * @return None
+   */
+  void setSampleCallback(sampleCallback_t callback);
+
+  /**
+   * @fn getSensorCount
+   * @brief Get the number of registered sensors
+   * @return uint8_t, the number of registered sensors
+   */
+  uint8_t getSensorCount(void);
+
+  /**
+   * @fn getSensor
+   * @brief Get a registered sensor
+   * @param index index returned by addSensor()
+   * @return DFRobot_RS01 pointer, NULL if the index is out of range
+   */
+  DFRobot_RS01 *getSensor(uint8_t index);
+
+  /**
+   * @fn getLastError
+   * @brief Get the result of the last measurement read of a sensor
+   * @param index index returned by addSensor()
+   * @return uint8_t, 0 means read succeeds, otherwise the RTU exception code
+   */
+  uint8_t getLastError(uint8_t index);
+
+  /**
+   * @fn broadcastAllMeasurementParameters
+   * @brief Configure the measurement parameters of every sensor on the bus with a single broadcast frame
+   * @n     The values are checked like setAllMeasurementParameters(), starting from the previous broadcast(the factory defaults at first).
+   * @n     The cached configuration of every registered sensor is invalidated
+   * @param startingPosition value at start position, 70~6600(0x0046~0x19C8)
+   * @param stopPosition value at stop position, 70~6600(0x0046~0x19C8)
+   * @param initialThreshold initial threshold, 100~10000(0x0064~0x2710)
+   * @param endThreshold end threshold, 100~10000(0x0064~0x2710)
+   * @param moduleSensitivity module sensitivity, 0x0000~0x0004
+   * @param comparisonOffset comparison offset, -32768~32767(0~0xFFFF)
+   * @param verify true to read the parameters back from every registered sensor, RS01_BROADCAST_SETTLE_MS after the frame
+   * @return int type, the number of registered sensors that failed the verification, 0 without verify
+   * @retval -1 the broadcast frame couldn't be sent
+   */
+  int broadcastAllMeasurementParameters(uint16_t startingPosition, uint16_t stopPosition,
+                                        uint16_t initialThreshold, uint16_t endThreshold,
+                                        uint16_t moduleSensitivity, uint16_t comparisonOffset,
+                                        bool verify = false);
+
+  /**
+   * @fn broadcastRestoreFactorySetting
+   * @brief Restore every sensor on the bus to factory setting with a single broadcast frame
+   * @n     Like every broadcast it goes straight to the serial port, outside the frame timing of DFRobot_RTU
+   * @return uint8_t, 0 means the frame has been sent
+   */
+  uint8_t broadcastRestoreFactorySetting(void);
+
+  #define ERR_BUS_FULL      (-3)   ///< no free sensor slot on the bus
+
+protected:
+  /**
+   * @fn waitInterFrame
+   * @brief Wait until the modbus inter-frame silence since the previous frame has elapsed
+   * @return None
+   */
+  void waitInterFrame(void);
+
+  /**
+   * @fn markFrameEnd
+   * @brief Record the end of a transaction, the next request keeps the inter-frame silence from here
+   * @return None
+   */
+  void markFrameEnd(void);
+
+  typedef struct
+  {
+    DFRobot_RS01 *sensor;   /**< the registered sensor */
+    uint8_t weight;   /**< configured share of the poll schedule */
+    int16_t current;   /**< smooth weighted round-robin credit */
+    uint8_t lastError;   /**< result of the last measurement read */
+  }sBusSlot_t;
+
+  Stream *_stream;   // serial port of the RS485 segment
+  DFRobot_RTU _rtu;   // the modbus-RTU instance shared by every sensor on the bus
+  DFRobot_RS01 _broadcast;   // sends the broadcast frames
+  sBusSlot_t _slots[RS01_BUS_MAX_SENSORS];   // registered sensors
+  uint8_t _count;   // number of registered sensors
+  uint16_t _totalWeight;   // sum of the weights of all sensors
+  uint32_t _interFrameUs;   // 3.5 character silence at the current baud rate
+  uint32_t _lastFrameUs;   // time the previous transaction ended
+  sampleCallback_t _sampleCallback;   // sample callback
+};
+
+#endif
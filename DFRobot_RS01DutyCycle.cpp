@@ -0,0 +1,167 @@
+/*!
+ * @file  DFRobot_RS01DutyCycle.cpp
+ * @brief  Define the infrastructure DFRobot_RS01DutyCycle class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01DutyCycle.h"
+
+DFRobot_RS01DutyCycle::DFRobot_RS01DutyCycle(DFRobot_RS01 *sensor)
+{
+  _sensor = sensor;
+  _transceiverHook = NULL;
+  _powerHook = NULL;
+  _sleepHook = NULL;
+  _publishCallback = NULL;
+  _periodMs = RS01_DUTY_DEFAULT_PERIOD_MS;
+  memset(&_snapshot, 0, sizeof(_snapshot));
+  resetStats();
+}
+
+void DFRobot_RS01DutyCycle::setTransceiverHook(switchHook_t hook)
+{
+  _transceiverHook = hook;
+}
+
+void DFRobot_RS01DutyCycle::setSensorPowerHook(switchHook_t hook)
+{
+  _powerHook = hook;
+}
+
+void DFRobot_RS01DutyCycle::setSleepHook(sleepHook_t hook)
+{
+  _sleepHook = hook;
+}
+
+void DFRobot_RS01DutyCycle::setPublishCallback(publishCallback_t callback)
+{
+  _publishCallback = callback;
+}
+
+void DFRobot_RS01DutyCycle::setPeriod(uint32_t ms)
+{
+  _periodMs = ms;
+}
+
+uint8_t DFRobot_RS01DutyCycle::begin(void)
+{
+  if(!_sensor->getSnapshot(&_snapshot)){
+    uint8_t ret = _sensor->refreshAll();
+    if(ret){
+      return ret;
+    }
+    if(!_sensor->getSnapshot(&_snapshot)){
+      DBG("staged writes pending");
+      return DFRobot_RTU::eRTU_MEMORY_ERROR;
+    }
+  }
+  _sensor->setSnapshot(&_snapshot);
+  return 0;
+}
+
+uint8_t DFRobot_RS01DutyCycle::wake(void)
+{
+  if(_transceiverHook){
+    _transceiverHook(true);
+  }
+  if(NULL == _powerHook){
+    return 0;   // The sensor stayed powered, its state is still cached
+  }
+
+  uint32_t startUs = micros();
+  _powerHook(true);
+  int ret = _sensor->restart();   // Probes until the sensor answers, no fixed power-up delay
+  if(ERR_IC_VERSION == ret){
+    return RS01_PID_MISMATCH;
+  }
+  if(NO_ERROR != ret){
+    return DFRobot_RTU::eRTU_RECV_ERROR;
+  }
+  _stats.lastReadyUs = micros() - startUs;
+  if(_stats.lastReadyUs > _stats.maxReadyUs){
+    _stats.maxReadyUs = _stats.lastReadyUs;
+  }
+  return 0;
+}
+
+void DFRobot_RS01DutyCycle::sleep(void)
+{
+  if(_powerHook){
+    _powerHook(false);
+  }
+  if(_transceiverHook){
+    _transceiverHook(false);
+  }
+}
+
+uint8_t DFRobot_RS01DutyCycle::cycle(void)
+{
+  uint32_t startMs = millis();
+  uint32_t startUs = micros();
+  _stats.cycles++;
+
+  uint8_t ret = wake();
+  if(0 == ret){
+    if(_powerHook && !_sensor->isSnapshotRestored()){
+      // Another sensor, new firmware or new settings: refreshAll() reads the measurement along with the configuration
+      _stats.snapshotMisses++;
+      ret = _sensor->refreshAll();
+      if((0 == ret) && _sensor->getSnapshot(&_snapshot)){
+        _sensor->setSnapshot(&_snapshot);   // The sensor keeps a copy, hand it the fresh one
+      }
+    }else{
+      ret = _sensor->refreshMeasurementData();   // One transaction, the single read of the cycle
+    }
+  }
+  if(_publishCallback){
+    _publishCallback(_sensor, ret);
+  }
+  sleep();
+
+  _stats.lastAwakeUs = micros() - startUs;
+  if(_stats.lastAwakeUs > _stats.maxAwakeUs){
+    _stats.maxAwakeUs = _stats.lastAwakeUs;
+  }
+  _totalAwakeUs += _stats.lastAwakeUs;
+  if(ret){
+    _stats.errors++;
+  }else{
+    _stats.samples++;
+  }
+
+  uint32_t elapsedMs = millis() - startMs;
+  if(elapsedMs < _periodMs){
+    uint32_t sleepMs = _periodMs - elapsedMs;
+    _stats.totalSleepMs += sleepMs;
+    if(_sleepHook){
+      _sleepHook(sleepMs);
+    }else{
+      delay(sleepMs);
+    }
+  }
+  return ret;
+}
+
+const DFRobot_RS01::sSnapshot_t *DFRobot_RS01DutyCycle::getSnapshot(void)
+{
+  return &_snapshot;
+}
+
+void DFRobot_RS01DutyCycle::getStats(sDutyStats_t *stats)
+{
+  *stats = _stats;
+  stats->totalAwakeMs = _totalAwakeUs / 1000;
+  stats->awakeUsPerSample = _stats.samples ? (uint32_t)(_totalAwakeUs / _stats.samples) : 0;
+  uint64_t totalMs = (uint64_t)stats->totalAwakeMs + _stats.totalSleepMs;
+  stats->dutyPermille = totalMs ? (uint16_t)((uint64_t)stats->totalAwakeMs * 1000 / totalMs) : 0;
+}
+
+void DFRobot_RS01DutyCycle::resetStats(void)
+{
+  memset(&_stats, 0, sizeof(_stats));
+  _totalAwakeUs = 0;
+}
@@ -0,0 +1,177 @@
+/*!
+ * @file  DFRobot_RS01DutyCycle.h
+ * @brief  Define infrastructure of DFRobot_RS01DutyCycle class
+ * @details  Duty-cycled acquisition for battery deployments: every period the sensor is woken, read once, the frame
+ * @n        is published and everything is put back to sleep. Hooks switch the RS485 transceiver and the sensor supply,
+ * @n        after a power-up the sensor is restarted on the fast-start path(setSnapshot()), so a wake costs the
+ * @n        readiness probe and one read instead of the fixed begin() delays. The awake time of every cycle is measured.
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_DUTY_CYCLE_H__
+#define __DFROBOT_RS01_DUTY_CYCLE_H__
+
+#include "DFRobot_RS01.h"
+
+#define RS01_DUTY_DEFAULT_PERIOD_MS   5000   ///< default time between the starts of two cycles
+
+class DFRobot_RS01DutyCycle
+{
+public:
+  /**
+   * @struct sDutyStats_t
+   * @brief Energy-relevant timing of the cycles since the last resetStats()
+   */
+  typedef struct
+  {
+    uint32_t cycles;   /**< wakes */
+    uint32_t samples;   /**< cycles that published a fresh frame */
+    uint32_t errors;   /**< cycles whose start-up or read failed */
+    uint32_t snapshotMisses;   /**< power-ups where the snapshot was stale and the configuration was read again */
+    uint32_t lastReadyUs;   /**< last power-up until the sensor answered, 0 without a power hook */
+    uint32_t maxReadyUs;   /**< longest power-up until the sensor answered */
+    uint32_t lastAwakeUs;   /**< last wake until everything was switched off again */
+    uint32_t maxAwakeUs;   /**< longest awake time of a cycle */
+    uint32_t awakeUsPerSample;   /**< total awake time divided by samples, the figure to budget the battery with */
+    uint32_t totalAwakeMs;   /**< awake time of all cycles */
+    uint32_t totalSleepMs;   /**< time handed to the sleep hook */
+    uint16_t dutyPermille;   /**< awake share of awake plus sleep time, in 1/1000 */
+  }sDutyStats_t;
+
+  /**
+   * @brief Switch a part on or off: the RS485 transceiver(DE/RE pins, and the host UART if wanted) or the sensor supply
+   * @param on true to switch on
+   */
+  typedef void (*switchHook_t)(bool on);
+
+  /**
+   * @brief Sleep between two cycles, e.g. a light sleep with a timer wake-up, delay() when not set
+   * @param ms time until the next cycle is due
+   */
+  typedef void (*sleepHook_t)(uint32_t ms);
+
+  /**
+   * @brief Called once per cycle while the sensor is still awake
+   * @param sensor the sensor, measurement/dataBuf hold the frame when ret is 0
+   * @param ret 0 means a fresh frame was read, otherwise the RTU exception code
+   */
+  typedef void (*publishCallback_t)(DFRobot_RS01 *sensor, uint8_t ret);
+
+  /**
+   * @fn DFRobot_RS01DutyCycle
+   * @brief constructor
+   * @param sensor the sensor to duty-cycle, its begin() must have succeeded before begin() here
+   * @return None
+   */
+  DFRobot_RS01DutyCycle(DFRobot_RS01 *sensor);
+
+  /**
+   * @fn setTransceiverHook
+   * @brief Set the hook switching the RS485 transceiver, on before the first frame of a cycle, off after the last
+   * @param hook the hook, NULL(default) leaves the transceiver on
+   * @return None
+   */
+  void setTransceiverHook(switchHook_t hook);
+
+  /**
+   * @fn setSensorPowerHook
+   * @brief Set the hook switching the sensor supply, the sensor is then restarted with restart() after every power-up
+   * @param hook the hook, NULL(default) keeps the sensor powered and only reads it
+   * @return None
+   */
+  void setSensorPowerHook(switchHook_t hook);
+
+  /**
+   * @fn setSleepHook
+   * @brief Set how the host waits for the next cycle
+   * @param hook the hook, NULL(default) uses delay()
+   * @return None
+   */
+  void setSleepHook(sleepHook_t hook);
+
+  /**
+   * @fn setPublishCallback
+   * @brief Set the callback handing each frame on
+   * @param callback the callback, NULL to disable
+   * @return None
+   */
+  void setPublishCallback(publishCallback_t callback);
+
+  /**
+   * @fn setPeriod
+   * @brief Set the time between the starts of two cycles
+   * @param ms period in ms, RS01_DUTY_DEFAULT_PERIOD_MS by default; a cycle longer than it starts the next one at once
+   * @return None
+   */
+  void setPeriod(uint32_t ms);
+
+  /**
+   * @fn begin
+   * @brief Take a snapshot of the sensor configuration for the fast start of the power-ups, reading it when not cached
+   * @n     After a deep sleep, restore a persisted snapshot with DFRobot_RS01::setSnapshot() before its begin(): the cache
+   * @n     is then complete and nothing is read here
+   * @return uint8_t, 0 means ready, otherwise the RTU exception code; eRTU_MEMORY_ERROR means staged writes are pending
+   */
+  uint8_t begin(void);
+
+  /**
+   * @fn cycle
+   * @brief Run one cycle: wake, restart after a power-up, read the measurement once, publish, switch off, sleep until the next is due
+   * @return uint8_t, 0 means a fresh frame was published, RS01_PID_MISMATCH another device answered the restart,
+   * @n     otherwise the RTU exception code
+   */
+  uint8_t cycle(void);
+
+  /**
+   * @fn getSnapshot
+   * @brief Get the snapshot used by the power-ups, to persist it across a deep sleep
+   * @return sSnapshot_t pointer, valid after begin() succeeded
+   */
+  const DFRobot_RS01::sSnapshot_t *getSnapshot(void);
+
+  /**
+   * @fn getStats
+   * @brief Get the timing of the cycles
+   * @param stats where to store it
+   * @return None
+   */
+  void getStats(sDutyStats_t *stats);
+
+  /**
+   * @fn resetStats
+   * @brief Clear the timing of the cycles
+   * @return None
+   */
+  void resetStats(void);
+
+private:
+  /**
+   * @fn wake
+   * @brief Switch the transceiver and the sensor on and restart the sensor after a power-up
+   * @return uint8_t, 0 means the sensor is ready, RS01_PID_MISMATCH another PID, otherwise the RTU exception code
+   */
+  uint8_t wake(void);
+
+  /**
+   * @fn sleep
+   * @brief Switch the sensor and the transceiver off
+   * @return None
+   */
+  void sleep(void);
+
+  DFRobot_RS01 *_sensor;   // the sensor
+  DFRobot_RS01::sSnapshot_t _snapshot;   // configuration restored by the power-ups
+  switchHook_t _transceiverHook;   // switches the RS485 transceiver
+  switchHook_t _powerHook;   // switches the sensor supply
+  sleepHook_t _sleepHook;   // waits for the next cycle
+  publishCallback_t _publishCallback;   // hands the frames on
+  uint32_t _periodMs;   // time between the starts of two cycles
+  sDutyStats_t _stats;   // timing of the cycles
+  uint64_t _totalAwakeUs;   // exact awake time, for awakeUsPerSample
+};
+
+#endif
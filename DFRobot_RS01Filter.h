@@ -0,0 +1,180 @@
+/*!
+ * @file  DFRobot_RS01Filter.h
+ * @brief  Define infrastructure of DFRobot_RS01Filter class
+ * @details  Fixed-point filter stage: range gate, N-tap median and exponential moving average
+ * @n        of the distance and intensity of every target slot, without floating point or allocation
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_FILTER_H__
+#define __DFROBOT_RS01_FILTER_H__
+
+#include "DFRobot_RS01Stage.h"
+
+#define RS01_FILTER_EMA_FRACTION   8   ///< fractional bits of the moving average state
+
+/**
+ * @brief Filter stage, the filtered values replace the raw ones in DFRobot_RS01::measurement, dataBuf keeps the raw registers
+ * @tparam Taps median window length, odd, 1~15, 1 disables the median
+ * @note The filter runs per target slot: slot n follows the nth nearest target,
+ * @n    a slot is restarted as soon as its target isn't reported.
+ * @n    Per sample the cost is independent of the history: the window is a ring with a sorted copy kept up to date
+ * @n    by one removal and one insertion, O(Taps) with Taps fixed at compile time.
+ */
+template<uint8_t Taps>
+class DFRobot_RS01Filter : public DFRobot_RS01Stage
+{
+  static_assert((Taps >= 1) && (Taps <= 15) && (Taps & 1), "Taps must be odd, 1~15");
+
+public:
+  DFRobot_RS01Filter(void) : _emaShift(0), _minDistance(0), _maxDistance(0), _rejected(0)
+  {
+    reset();
+  }
+
+  /**
+   * @fn setEMA
+   * @brief Configure the exponential moving average behind the median
+   * @param shift smoothing factor 1/2^shift, 0 disables the average, 1~8
+   * @return None
+   */
+  void setEMA(uint8_t shift)
+  {
+    _emaShift = (8 < shift) ? 8 : shift;
+    reset();
+  }
+
+  /**
+   * @fn setRange
+   * @brief Reject targets whose distance lies outside a window, they are removed from the measurement
+   * @param minDistance the nearest distance accepted
+   * @param maxDistance the farthest distance accepted, 0(default) uses measurementConfig.startPosition/stopPosition
+   * @n                 of the sensor, the factory window until refreshMeasurementConfig() or a setter updates it
+   * @return None
+   */
+  void setRange(uint16_t minDistance, uint16_t maxDistance)
+  {
+    _minDistance = minDistance;
+    _maxDistance = maxDistance;
+  }
+
+  /**
+   * @fn getRejected
+   * @brief Get the number of targets removed by the range gate
+   * @return uint32_t, the count
+   */
+  uint32_t getRejected(void) const { return _rejected; }
+
+  void reset(void)
+  {
+    for(uint8_t i = 0; i < 5; i++){
+      _distance[i].reset();
+      _intensity[i].reset();
+    }
+  }
+
+  void process(DFRobot_RS01 &sensor, DFRobot_RS01::sMeasurement_t &m)
+  {
+    uint16_t lo = _minDistance;
+    uint16_t hi = _maxDistance;
+    if(0 == hi){   // Follow the window the sensor is configured with
+      lo = sensor.measurementConfig.startPosition;
+      hi = sensor.measurementConfig.stopPosition;
+    }
+
+    uint8_t count = 0;
+    for(uint8_t i = 0; i < m.targetCount; i++){   // Compact the accepted targets, nearest first
+      if((m.distance[i] < lo) || (m.distance[i] > hi)){
+        _rejected++;
+        continue;
+      }
+      m.distance[count] = m.distance[i];
+      m.intensity[count] = m.intensity[i];
+      count++;
+    }
+    m.targetCount = count;
+
+    for(uint8_t i = 0; i < 5; i++){
+      if(i < count){
+        m.distance[i] = _distance[i].update(m.distance[i], _emaShift);
+        m.intensity[i] = _intensity[i].update(m.intensity[i], _emaShift);
+      }else{
+        m.distance[i] = 0;
+        m.intensity[i] = 0;
+        _distance[i].reset();   // The target is gone, don't blend the next one into its history
+        _intensity[i].reset();
+      }
+    }
+  }
+
+private:
+  /* Median window and moving average of one value */
+  struct sChannel_t
+  {
+    uint16_t ring[Taps];   // the last samples in arrival order
+    uint16_t sorted[Taps];   // the same samples sorted
+    uint8_t pos;   // next ring slot, the oldest sample once the window is full
+    uint8_t fill;   // samples in the window
+    uint32_t ema;   // moving average state, RS01_FILTER_EMA_FRACTION fractional bits
+    bool primed;   // ema holds a value
+
+    void reset(void)
+    {
+      pos = 0;
+      fill = 0;
+      primed = false;
+    }
+
+    uint16_t update(uint16_t value, uint8_t shift)
+    {
+      uint8_t n = fill;
+      if(Taps == fill){   // Drop the oldest sample from the sorted copy
+        uint16_t old = ring[pos];
+        uint8_t j = 0;
+        while(sorted[j] != old){
+          j++;
+        }
+        for(n--; j < n; j++){
+          sorted[j] = sorted[j + 1];
+        }
+      }else{
+        fill++;
+      }
+      ring[pos] = value;
+      pos = ((Taps - 1) == pos) ? 0 : (pos + 1);
+      while(n && (sorted[n - 1] > value)){   // Insert the new one in order
+        sorted[n] = sorted[n - 1];
+        n--;
+      }
+      sorted[n] = value;
+      uint16_t median = sorted[fill / 2];
+
+      if(0 == shift){
+        return median;
+      }
+      uint32_t x = (uint32_t)median << RS01_FILTER_EMA_FRACTION;
+      if(!primed){   // Start the average at the first value instead of ramping up from 0
+        ema = x;
+        primed = true;
+      }else if(x > ema){
+        ema += (x - ema) >> shift;
+      }else{
+        ema -= (ema - x) >> shift;
+      }
+      return (uint16_t)((ema + (1UL << (RS01_FILTER_EMA_FRACTION - 1))) >> RS01_FILTER_EMA_FRACTION);
+    }
+  };
+
+  sChannel_t _distance[5];   // distance of every target slot
+  sChannel_t _intensity[5];   // intensity of every target slot
+  uint8_t _emaShift;   // smoothing factor 1/2^shift, 0 off
+  uint16_t _minDistance;   // range gate, nearest distance accepted
+  uint16_t _maxDistance;   // range gate, farthest distance accepted, 0 follows measurementConfig
+  uint32_t _rejected;   // targets removed by the range gate
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*!
+ * @file  DFRobot_RS01IRQTransport.cpp
+ * @brief  Define the infrastructure DFRobot_RS01IRQTransport class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01IRQTransport.h"
+#include "DFRobot_RS01.h"
+
+/* Mask the interrupts and give back the previous mask, so that a caller running with them masked keeps it so */
+static inline uint32_t irqSave(void)
+{
+#if defined(__AVR__)
+  uint32_t state = SREG;
+  cli();
+  return state;
+#elif defined(ESP32)
+  return (uint32_t)portSET_INTERRUPT_MASK_FROM_ISR();
+#elif defined(ESP8266)
+  return (uint32_t)xt_rsil(15);
+#elif defined(__arm__)
+  uint32_t state;
+  __asm__ __volatile__("mrs %0, primask\n\tcpsid i" : "=r"(state) :: "memory");
+  return state;
+#else
+  noInterrupts();   // The mask can't be read here, take it as open
+  return 1;
+#endif
+}
+
+static inline void irqRestore(uint32_t state)
+{
+#if defined(__AVR__)
+  SREG = (uint8_t)state;
+#elif defined(ESP32)
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+#elif defined(ESP8266)
+  xt_wsr_ps(state);
+#elif defined(__arm__)
+  __asm__ __volatile__("msr primask, %0" :: "r"(state) : "memory");
+#else
+  if(state){
+    interrupts();
+  }
+#endif
+}
+
+#define RS01_IRQ_MAX_RESPONSE   (5 + 2 * RS01_TRANSPORT_MAX_REGS)   ///< longest response a transaction can expect
+
+DFRobot_RS01IRQTransport::DFRobot_RS01IRQTransport(sendFrame_t send)
+  : _send(send)
+{
+  _inFlight = NULL;
+  _sentMs = 0;
+  _rxFrame = NULL;
+  _rxLen = 0;
+  _txLen = 0;
+}
+
+void DFRobot_RS01IRQTransport::onFrameReceived(const uint8_t *frame, uint16_t len)
+{
+  _rxLen = len;
+  _rxFrame = frame;   // Published last, service() reads the length after seeing the pointer
+}
+
+bool DFRobot_RS01IRQTransport::isIdle(void)
+{
+  return (NULL == _inFlight) && DFRobot_RS01Transport::isIdle();
+}
+
+void DFRobot_RS01IRQTransport::service(void)
+{
+  uint32_t irq = irqSave();   // Take the frame and clear the slot at once, a frame published in between would be lost
+  const uint8_t *frame = _rxFrame;
+  uint16_t len = _rxLen;
+  _rxFrame = NULL;
+  irqRestore(irq);
+  if(frame){
+    bool echo = (len == _txLen) && (0 == memcmp(frame, _txBuf, len));   // Our own request, the response is still to come
+    if(_inFlight && !echo && (len >= 5) && (frame[0] == _inFlight->addr)){   // Anything else is noise or another slave
+      sTransaction_t *t = _inFlight;
+      _inFlight = NULL;
+      uint8_t ret;
+      if((RS01_IRQ_MAX_RESPONSE < len) || (0 != DFRobot_RS01::calculateCRC16(frame, len))){
+        ret = DFRobot_RTU::eRTU_EXCEPTION_CRC_ERROR;   // Too long for any response: a garbled or merged frame, parsePDU() takes 8 bits
+      }else{
+        ret = parsePDU(t, &frame[1], (uint8_t)(len - 3));
+      }
+      complete(t, ret);
+    }
+  }
+
+  if(_inFlight && ((millis() - _sentMs) > timeoutOf(_inFlight))){
+    sTransaction_t *t = _inFlight;
+    _inFlight = NULL;
+    complete(t, DFRobot_RTU::eRTU_RECV_ERROR);
+  }
+
+  if(NULL == _inFlight){
+    sTransaction_t *t = dequeue();
+    if(t){
+      _txBuf[0] = t->addr;
+      uint8_t len = 1 + buildPDU(t, &_txBuf[1]);
+      uint16_t crc = DFRobot_RS01::calculateCRC16(_txBuf, len);
+      _txBuf[len++] = (uint8_t)(crc & 0xFF);
+      _txBuf[len++] = (uint8_t)(crc >> 8);
+      _txLen = len;
+      _sentMs = millis();
+      _send(_txBuf, len);
+      if(0 == t->addr){
+        complete(t, 0);   // Nobody answers a broadcast
+      }else{
+        _inFlight = t;
+      }
+    }
+  }
+}
@@ -0,0 +1,60 @@
+/*!
+ * @file  DFRobot_RS01IRQTransport.h
+ * @brief  Define infrastructure of DFRobot_RS01IRQTransport class
+ * @details  Modbus-RTU backend for UARTs that move whole frames by DMA and report them with an idle-line interrupt,
+ * @n        the CPU only sees one call per frame instead of one per byte
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_IRQ_TRANSPORT_H__
+#define __DFROBOT_RS01_IRQ_TRANSPORT_H__
+
+#include "DFRobot_RS01Transport.h"
+
+class DFRobot_RS01IRQTransport : public DFRobot_RS01Transport
+{
+public:
+  /**
+   * @brief Start sending a complete RTU frame, e.g. HAL_UART_Transmit_DMA(), must return without waiting
+   * @param frame the frame, stays valid until the response is handed over or the transaction expires
+   * @param len frame length
+   */
+  typedef void (*sendFrame_t)(const uint8_t *frame, uint8_t len);
+
+  /**
+   * @fn DFRobot_RS01IRQTransport
+   * @brief constructor
+   * @param send function starting the transmission
+   * @return None
+   */
+  DFRobot_RS01IRQTransport(sendFrame_t send);
+
+  /**
+   * @fn onFrameReceived
+   * @brief Hand a received frame over, call it from the idle-line/DMA interrupt
+   * @n     Only the pointer is stored, the frame is parsed in place by the next service(); a local echo of the
+   * @n     request(half-duplex transceiver with the receiver left on) is recognised and skipped
+   * @param frame the received bytes, must stay untouched until service() ran, double-buffer the DMA target
+   * @param len number of bytes
+   * @return None
+   */
+  void onFrameReceived(const uint8_t *frame, uint16_t len);
+
+  void service(void);
+  bool isIdle(void);
+
+private:
+  sendFrame_t _send;   // starts a transmission
+  sTransaction_t *_inFlight;   // the transaction awaiting its response, RTU allows one at a time
+  uint32_t _sentMs;   // time the request was sent
+  const uint8_t * volatile _rxFrame;   // frame handed over by the interrupt, NULL when none
+  volatile uint16_t _rxLen;   // its length
+  uint8_t _txBuf[1 + 6 + 2 * RS01_TRANSPORT_MAX_REGS + 2];   // request being sent
+  uint8_t _txLen;   // its length, to recognise a local echo
+};
+
+#endif
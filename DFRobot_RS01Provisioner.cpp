@@ -0,0 +1,314 @@
+/*!
+ * @file  DFRobot_RS01Provisioner.cpp
+ * @brief  Define the infrastructure DFRobot_RS01Provisioner class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01Provisioner.h"
+
+DFRobot_RS01Provisioner::DFRobot_RS01Provisioner(DFRobot_RS01Transport *transport)
+{
+  _transport = transport;
+  _scanTimeoutMs = RS01_PROVISION_SCAN_TIMEOUT_MS;
+  _count = 0;
+  _foreign = 0;
+  _garbled = 0;
+  _blocks = 0;
+  _broadcast = false;
+  _scanMs = 0;
+  _applyMs = 0;
+  for(uint8_t i = 0; i < RS01_PROVISION_WINDOW; i++){
+    _slots[i].t.state = DFRobot_RS01Transport::eTransactionIdle;
+  }
+}
+
+void DFRobot_RS01Provisioner::setScanTimeout(uint32_t ms)
+{
+  _scanTimeoutMs = ms;
+}
+
+uint8_t DFRobot_RS01Provisioner::scan(uint8_t first, uint8_t last)
+{
+  uint32_t startMs = millis();
+  uint32_t timeoutMs = _transport->getTimeout();
+  _transport->setTimeout(_scanTimeoutMs);   // An absent address mustn't cost the full timeout
+  _count = 0;
+  _foreign = 0;
+  _garbled = 0;
+
+  uint16_t next = first;   // 16 bits, so that last = 247 ends the loop
+  uint8_t busy = 0;
+  while((next <= last) || busy){
+    for(uint8_t i = 0; i < RS01_PROVISION_WINDOW; i++){
+      sSlot_t *slot = &_slots[i];
+      if(DFRobot_RS01Transport::eTransactionDone == slot->t.state){
+        slot->t.state = DFRobot_RS01Transport::eTransactionIdle;
+        busy--;
+        uint8_t ret = slot->t.ret;
+        if((0 == ret) && (RS01_PID == slot->buf[0])){
+          if(_count < RS01_PROVISION_MAX_SENSORS){
+            sProvisionResult_t *result = &_results[_count++];
+            result->addr = slot->t.addr;
+            result->status = eProvisionFound;
+            result->ret = 0;
+            result->version = slot->buf[5];
+          }else{
+            DBG("report full");
+          }
+        }else if(DFRobot_RTU::eRTU_EXCEPTION_CRC_ERROR == ret){
+          _garbled++;
+        }else if((0 == ret) || (DFRobot_RTU::eRTU_EXCEPTION_SLAVE_FAILURE >= ret)){
+          _foreign++;   // Something answered, a wrong PID or an exception
+        }
+      }
+      if((DFRobot_RS01Transport::eTransactionIdle == slot->t.state) && (next <= last)){
+        DFRobot_RS01Transport::sTransaction_t *t = &slot->t;
+        t->addr = (uint8_t)next++;
+        t->function = 0x03;
+        t->reg = RS01_PID_REG;
+        t->count = 6;   // PID up to the firmware version, as cheap as the PID alone on the wire
+        t->pBuf = slot->buf;
+        t->callback = NULL;
+        t->context = NULL;
+        t->timeoutMs = 0;
+        if(_transport->submit(t)){
+          busy++;
+        }
+      }
+    }
+    _transport->service();
+    yield();
+  }
+
+  _transport->setTimeout(timeoutMs);
+  // Completions arrive out of order on pipelining backends, keep the report in address order
+  for(uint8_t i = 1; i < _count; i++){
+    sProvisionResult_t result = _results[i];
+    uint8_t j = i;
+    while(j && (_results[j - 1].addr > result.addr)){
+      _results[j] = _results[j - 1];
+      j--;
+    }
+    _results[j] = result;
+  }
+  _scanMs = millis() - startMs;
+  return _count;
+}
+
+uint8_t DFRobot_RS01Provisioner::getForeignCount(void)
+{
+  return _foreign;
+}
+
+uint8_t DFRobot_RS01Provisioner::getGarbledCount(void)
+{
+  return _garbled;
+}
+
+bool DFRobot_RS01Provisioner::setTarget(const sProvisionTarget_t *target)
+{
+  const DFRobot_RS01::sMeasurementConfig_t *m = &target->measurement;
+  if((target->fields & RS01_PROVISION_BAUDRATE) &&
+     ((DFRobot_RS01::eBaudrate2400 > target->baudrate) || (DFRobot_RS01::eBaudrate_1000000 < target->baudrate))){
+    DBG("baud rate out of range");
+    return false;
+  }
+  if((target->fields & RS01_PROVISION_CHECKBIT_STOPBIT) &&
+     ((DFRobot_RS01::eCheckBitOdd < (target->checkbitStopbit & 0xFF00)) ||
+      ((DFRobot_RS01::eStopBit1 != (target->checkbitStopbit & 0x00FF)) && (DFRobot_RS01::eStopBit2 != (target->checkbitStopbit & 0x00FF))))){
+    DBG("check bit or stop bit out of range");
+    return false;
+  }
+  if((target->fields & RS01_PROVISION_MEASUREMENT) &&
+     ((0x0046 > m->startPosition) || (m->startPosition > m->stopPosition) || (0x19C8 < m->stopPosition) ||
+      (0x0064 > m->initialThreshold) || (0x2710 < m->initialThreshold) ||
+      (0x0064 > m->endThreshold) || (0x2710 < m->endThreshold) || (0x0004 < m->moduleSensitivity) ||
+      (0 >= int16_t(m->initialThreshold + m->comparisonOffset)) || (0 >= int16_t(m->endThreshold + m->comparisonOffset)))){
+    DBG("measurement parameter out of range");
+    return false;
+  }
+
+  _values[0] = target->baudrate;
+  _values[1] = target->checkbitStopbit;
+  memcpy(&_values[2], m, 6 * sizeof(uint16_t));
+
+  _blocks = 0;   // Neighbouring registers go in one write
+  if(target->fields & (RS01_PROVISION_BAUDRATE | RS01_PROVISION_CHECKBIT_STOPBIT)){
+    bool baud = target->fields & RS01_PROVISION_BAUDRATE;
+    bool check = target->fields & RS01_PROVISION_CHECKBIT_STOPBIT;
+    _blockReg[_blocks] = baud ? RS01_BAUDRATE_REG : RS01_CHECKBIT_STOPBIT_REG;
+    _blockOffset[_blocks] = baud ? 0 : 1;
+    _blockCount[_blocks] = (baud && check) ? 2 : 1;
+    _blocks++;
+  }
+  if(target->fields & RS01_PROVISION_MEASUREMENT){
+    _blockReg[_blocks] = MEASUREMENT_START_POSITION;
+    _blockOffset[_blocks] = 2;
+    _blockCount[_blocks] = 6;
+    _blocks++;
+  }
+  return true;
+}
+
+void DFRobot_RS01Provisioner::setBroadcast(bool enable)
+{
+  _broadcast = enable;
+}
+
+uint8_t DFRobot_RS01Provisioner::apply(void)
+{
+  uint32_t startMs = millis();
+  bool broadcast = _broadcast && (0 == _foreign) && (0 == _garbled);
+  if(broadcast){
+    for(uint8_t b = 0; b < _blocks; b++){
+      DFRobot_RS01Transport::sTransaction_t t = {RS01_BROADCAST_ADDR, 0x10, _blockReg[b], _blockCount[b], &_values[_blockOffset[b]],
+                                                 DFRobot_RS01Transport::eTransactionIdle, 0, NULL, NULL, NULL, 0};
+      if(_transport->transfer(&t)){
+        DBG("broadcast failed, writing one by one");
+        broadcast = false;
+        break;
+      }
+    }
+    if(broadcast){
+      delay(RS01_PROVISION_BROADCAST_SETTLE_MS);
+    }
+  }
+
+  uint8_t next = 0;
+  uint8_t busy = 0;
+  uint8_t verified = 0;
+  while((_blocks && (next < _count)) || busy){
+    for(uint8_t i = 0; i < RS01_PROVISION_WINDOW; i++){
+      sSlot_t *slot = &_slots[i];
+      if((DFRobot_RS01Transport::eTransactionDone == slot->t.state) && finishStep(slot)){
+        slot->t.state = DFRobot_RS01Transport::eTransactionIdle;
+        busy--;
+        if(eProvisionVerified == _results[slot->index].status){
+          verified++;
+        }
+      }
+      if((DFRobot_RS01Transport::eTransactionIdle == slot->t.state) && (next < _count)){
+        slot->index = next++;
+        slot->step = broadcast ? _blocks : 0;   // Broadcast: straight to the read-back
+        slot->rewritten = !broadcast;
+        _results[slot->index].ret = 0;
+        busy++;
+        submitStep(slot);
+      }
+    }
+    _transport->service();
+    yield();
+  }
+  _applyMs = millis() - startMs;
+  return verified;
+}
+
+void DFRobot_RS01Provisioner::submitStep(sSlot_t *slot)
+{
+  DFRobot_RS01Transport::sTransaction_t *t = &slot->t;
+  uint8_t block = (slot->step < _blocks) ? slot->step : (slot->step - _blocks);
+  t->addr = _results[slot->index].addr;
+  t->function = (slot->step < _blocks) ? 0x10 : 0x03;
+  t->reg = _blockReg[block];
+  t->count = _blockCount[block];
+  t->pBuf = (0x10 == t->function) ? &_values[_blockOffset[block]] : slot->buf;
+  t->callback = NULL;
+  t->context = NULL;
+  t->timeoutMs = 0;
+  if(!_transport->submit(t)){
+    t->state = DFRobot_RS01Transport::eTransactionDone;   // Report it as failed on the next round
+    t->ret = DFRobot_RTU::eRTU_MEMORY_ERROR;
+  }
+}
+
+bool DFRobot_RS01Provisioner::finishStep(sSlot_t *slot)
+{
+  sProvisionResult_t *result = &_results[slot->index];
+  bool write = slot->step < _blocks;
+  if(slot->t.ret){
+    result->ret = slot->t.ret;
+    result->status = write ? eProvisionWriteFailed : eProvisionReadFailed;
+    return true;
+  }
+  if(!write && !blockMatches(slot->step - _blocks, slot->buf)){
+    if(!slot->rewritten){   // The broadcast didn't reach this one, write it with its own address
+      slot->rewritten = true;
+      slot->step = 0;
+      submitStep(slot);
+      return false;
+    }
+    result->status = eProvisionMismatch;
+    return true;
+  }
+  if(++slot->step >= 2 * _blocks){
+    result->status = eProvisionVerified;
+    return true;
+  }
+  submitStep(slot);
+  return false;
+}
+
+bool DFRobot_RS01Provisioner::blockMatches(uint8_t block, const uint16_t *pBuf)
+{
+  return 0 == memcmp(pBuf, &_values[_blockOffset[block]], _blockCount[block] * sizeof(uint16_t));
+}
+
+uint8_t DFRobot_RS01Provisioner::getCount(void)
+{
+  return _count;
+}
+
+const DFRobot_RS01Provisioner::sProvisionResult_t *DFRobot_RS01Provisioner::getResult(uint8_t index)
+{
+  return (index < _count) ? &_results[index] : NULL;
+}
+
+uint32_t DFRobot_RS01Provisioner::getScanMs(void)
+{
+  return _scanMs;
+}
+
+uint32_t DFRobot_RS01Provisioner::getApplyMs(void)
+{
+  return _applyMs;
+}
+
+void DFRobot_RS01Provisioner::printReport(Print *out)
+{
+  static const char *const statusText[] = {"found", "verified", "write failed", "read-back failed", "mismatch"};
+  uint8_t verified = 0;
+  for(uint8_t i = 0; i < _count; i++){
+    const sProvisionResult_t *result = &_results[i];
+    out->print("addr 0x");
+    out->print(result->addr, HEX);
+    out->print("  fw 0x");
+    out->print(result->version, HEX);
+    out->print("  ");
+    out->print(statusText[result->status]);
+    if(result->ret){
+      out->print("  code ");
+      out->print(result->ret);
+    }
+    out->println();
+    if(eProvisionVerified == result->status){
+      verified++;
+    }
+  }
+  out->print("found: ");
+  out->print(_count);
+  out->print("  verified: ");
+  out->print(verified);
+  out->print("  foreign: ");
+  out->print(_foreign);
+  out->print("  garbled: ");
+  out->print(_garbled);
+  out->print("  scan: ");
+  out->print(_scanMs);
+  out->print(" ms  apply: ");
+  out->print(_applyMs);
+  out->println(" ms");
+}
@@ -0,0 +1,232 @@
+/*!
+ * @file  DFRobot_RS01Provisioner.h
+ * @brief  Define infrastructure of DFRobot_RS01Provisioner class
+ * @details  Commissioning of many sensors behind one transport: scan the bus for RS01 sensors with a short timeout,
+ * @n        apply one target configuration to all of them and verify it by reading it back, with a per-sensor report.
+ * @n        Several transactions are kept in flight, the transport runs them in parallel when the backend can.
+ * @note Sensors sharing an address answer together and can't be told apart, give them unique addresses first(setModuleInfo.ino)
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_PROVISIONER_H__
+#define __DFROBOT_RS01_PROVISIONER_H__
+
+#include "DFRobot_RS01.h"
+
+#ifndef RS01_PROVISION_MAX_SENSORS
+  #define RS01_PROVISION_MAX_SENSORS  64     ///< sensors one scan can record, define it before including this file to change it
+#endif
+#ifndef RS01_PROVISION_WINDOW
+  #define RS01_PROVISION_WINDOW       4      ///< transactions kept in flight
+#endif
+#define RS01_PROVISION_SCAN_TIMEOUT_MS      20     ///< default response timeout of a scan probe
+#define RS01_PROVISION_BROADCAST_SETTLE_MS  RS01_BROADCAST_SETTLE_MS   ///< pause after a broadcast write before the read-back
+
+/* Fields of sProvisionTarget_t to apply */
+#define RS01_PROVISION_BAUDRATE          0x01   ///< baudrate, takes effect after a power cycle
+#define RS01_PROVISION_CHECKBIT_STOPBIT  0x02   ///< checkbitStopbit, takes effect after a power cycle
+#define RS01_PROVISION_MEASUREMENT       0x04   ///< the six measurement parameters
+
+class DFRobot_RS01Provisioner
+{
+public:
+  /**
+   * @enum eProvisionStatus_t
+   * @brief Result of a sensor in the report
+   */
+  typedef enum
+  {
+    eProvisionFound = 0,   /**< answered the scan, nothing applied yet */
+    eProvisionVerified,   /**< the target was written and read back */
+    eProvisionWriteFailed,   /**< a write failed, ret holds the code */
+    eProvisionReadFailed,   /**< the read-back failed, ret holds the code */
+    eProvisionMismatch,   /**< the read-back differs from the target, the sensor refused a value */
+  }eProvisionStatus_t;
+
+  /**
+   * @struct sProvisionResult_t
+   * @brief One line of the report
+   */
+  typedef struct
+  {
+    uint8_t addr;   /**< modbus address */
+    uint8_t status;   /**< eProvisionStatus_t */
+    uint8_t ret;   /**< RTU exception code of the failing transaction, 0 if none */
+    uint16_t version;   /**< firmware revision number read by the scan */
+  }sProvisionResult_t;
+
+  /**
+   * @struct sProvisionTarget_t
+   * @brief Configuration every sensor is brought to, only the fields selected are written
+   */
+  typedef struct
+  {
+    uint8_t fields;   /**< RS01_PROVISION_BAUDRATE | RS01_PROVISION_CHECKBIT_STOPBIT | RS01_PROVISION_MEASUREMENT */
+    uint16_t baudrate;   /**< DFRobot_RS01::eBaudrateMode_t */
+    uint16_t checkbitStopbit;   /**< DFRobot_RS01::eCheckBitMode_t | DFRobot_RS01::eStopBitMode_t */
+    DFRobot_RS01::sMeasurementConfig_t measurement;   /**< start/stop position, thresholds, sensitivity, comparison offset */
+  }sProvisionTarget_t;
+
+  /**
+   * @fn DFRobot_RS01Provisioner
+   * @brief constructor
+   * @param transport the transport of the bus to commission
+   * @return None
+   */
+  DFRobot_RS01Provisioner(DFRobot_RS01Transport *transport);
+
+  /**
+   * @fn setScanTimeout
+   * @brief Set the response timeout of the scan probes, an absent address costs this long
+   * @param ms timeout in ms, RS01_PROVISION_SCAN_TIMEOUT_MS by default
+   * @return None
+   */
+  void setScanTimeout(uint32_t ms);
+
+  /**
+   * @fn scan
+   * @brief Probe the addresses for RS01 sensors(PID RS01_PID), RS01_PROVISION_WINDOW probes in flight
+   * @n     The sensors found start the report with eProvisionFound, previous results are cleared
+   * @param first first address, 1~247
+   * @param last last address, 1~247
+   * @return uint8_t, the number of RS01 sensors found
+   */
+  uint8_t scan(uint8_t first = 1, uint8_t last = 247);
+
+  /**
+   * @fn getForeignCount
+   * @brief Get the number of addresses of the last scan answered by another kind of device
+   * @return uint8_t, the number of foreign devices
+   */
+  uint8_t getForeignCount(void);
+
+  /**
+   * @fn getGarbledCount
+   * @brief Get the number of addresses of the last scan answered with CRC errors, a sign of two devices sharing it
+   * @return uint8_t, the number of garbled addresses
+   */
+  uint8_t getGarbledCount(void);
+
+  /**
+   * @fn setTarget
+   * @brief Set the configuration apply() writes, checked against the ranges of the setters
+   * @param target the target configuration, copied
+   * @return bool, false means a selected value is out of range and the target is refused
+   */
+  bool setTarget(const sProvisionTarget_t *target);
+
+  /**
+   * @fn setBroadcast
+   * @brief Write the target with one broadcast per register block, then read it back from every sensor
+   * @n     A sensor failing the read-back is written again with its own address. Ignored when the last
+   * @n     scan met foreign or garbled devices, they would receive the broadcast too.
+   * @param enable true to broadcast, false(default) writes every sensor with its own address
+   * @return None
+   */
+  void setBroadcast(bool enable);
+
+  /**
+   * @fn apply
+   * @brief Write the target to every sensor found by scan() and verify it, RS01_PROVISION_WINDOW sensors in flight
+   * @return uint8_t, the number of sensors verified
+   */
+  uint8_t apply(void);
+
+  /**
+   * @fn getCount
+   * @brief Get the number of sensors in the report
+   * @return uint8_t, the number of sensors
+   */
+  uint8_t getCount(void);
+
+  /**
+   * @fn getResult
+   * @brief Get one line of the report
+   * @param index 0~getCount()-1, in address order
+   * @return sProvisionResult_t pointer, NULL if the index is out of range
+   */
+  const sProvisionResult_t *getResult(uint8_t index);
+
+  /**
+   * @fn getScanMs
+   * @brief Get the duration of the last scan()
+   * @return uint32_t, in ms
+   */
+  uint32_t getScanMs(void);
+
+  /**
+   * @fn getApplyMs
+   * @brief Get the duration of the last apply()
+   * @return uint32_t, in ms
+   */
+  uint32_t getApplyMs(void);
+
+  /**
+   * @fn printReport
+   * @brief Print one line per sensor and a summary
+   * @param out where to print, e.g. &Serial
+   * @return None
+   */
+  void printReport(Print *out);
+
+private:
+  /**
+   * @struct sSlot_t
+   * @brief A transaction in flight and the sensor it belongs to
+   */
+  typedef struct
+  {
+    DFRobot_RS01Transport::sTransaction_t t;   /**< the transaction */
+    uint8_t index;   /**< sensor in _results */
+    uint8_t step;   /**< 0~_blocks-1 write block step, _blocks~2*_blocks-1 read block step-_blocks back */
+    bool rewritten;   /**< the broadcast didn't take, the sensor was written with its own address */
+    uint16_t buf[6];   /**< scan: registers 0x0000~0x0005, apply: read-back of one block */
+  }sSlot_t;
+
+  /**
+   * @fn submitStep
+   * @brief Queue the transaction of the current step of a slot
+   * @param slot the slot
+   * @return None
+   */
+  void submitStep(sSlot_t *slot);
+
+  /**
+   * @fn finishStep
+   * @brief Handle the completed transaction of a slot and move it to its next step
+   * @param slot the slot
+   * @return bool, true means the sensor is done
+   */
+  bool finishStep(sSlot_t *slot);
+
+  /**
+   * @fn blockMatches
+   * @brief Compare a read-back with the target values of its block
+   * @param block index of the block
+   * @param pBuf the registers read
+   * @return true means they match
+   */
+  bool blockMatches(uint8_t block, const uint16_t *pBuf);
+
+  DFRobot_RS01Transport *_transport;   // transport of the bus
+  uint32_t _scanTimeoutMs;   // response timeout of a scan probe
+  sProvisionResult_t _results[RS01_PROVISION_MAX_SENSORS];   // the report
+  uint8_t _count;   // sensors in the report
+  uint8_t _foreign;   // addresses answered by another kind of device
+  uint8_t _garbled;   // addresses answered with CRC errors
+  sSlot_t _slots[RS01_PROVISION_WINDOW];   // transactions in flight
+  uint16_t _values[2 + 6];   // target registers: baud rate, check/stop bit, the 6 measurement parameters
+  uint16_t _blockReg[2];   // first register of each block to write
+  uint8_t _blockCount[2];   // registers of each block
+  uint8_t _blockOffset[2];   // first value of each block in _values
+  uint8_t _blocks;   // blocks to write, 0 until setTarget()
+  bool _broadcast;   // broadcast the writes
+  uint32_t _scanMs;   // duration of the last scan
+  uint32_t _applyMs;   // duration of the last apply
+};
+
+#endif
@@ -0,0 +1,138 @@
+/*!
+ * @file  DFRobot_RS01SampleRing.h
+ * @brief  Define infrastructure of DFRobot_RS01SampleRing class
+ * @details  Fixed-capacity, allocation-free history of timestamped measurements,
+ * @n        one producer(poller or ISR) pushes while one consumer drains in batches, without locks
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_SAMPLE_RING_H__
+#define __DFROBOT_RS01_SAMPLE_RING_H__
+
+#include "DFRobot_RS01.h"
+
+/* Keep the slot writes ordered before the index that publishes them, dual core parts also need the hardware fence */
+#if defined(ESP32)
+  #define RS01_MEMORY_BARRIER()   __sync_synchronize()
+#else
+  #define RS01_MEMORY_BARRIER()   __asm__ __volatile__("" ::: "memory")
+#endif
+
+/**
+ * @brief Single-producer/single-consumer ring of DFRobot_RS01::sSample_t
+ * @tparam Capacity number of samples kept, a power of two from 2 to 128,
+ * @n      the 8-bit indices are read and written atomically on every MCU, AVR included
+ */
+template<uint8_t Capacity>
+class DFRobot_RS01SampleRing
+{
+  static_assert((Capacity >= 2) && (Capacity <= 128) && (0 == (Capacity & (Capacity - 1))),
+                "Capacity must be a power of two from 2 to 128");
+
+public:
+  DFRobot_RS01SampleRing(void) : _head(0), _tail(0), _dropped(0) {}
+
+  /**
+   * @fn push
+   * @brief Producer side: store a sample, a full ring drops the new sample and counts it
+   * @param sample the sample to store
+   * @return true means the sample is stored
+   */
+  bool push(const DFRobot_RS01::sSample_t &sample)
+  {
+    uint8_t head = _head;
+    if((uint8_t)(head - _tail) >= Capacity){
+      _dropped++;
+      return false;
+    }
+    _buf[head & (Capacity - 1)] = sample;
+    RS01_MEMORY_BARRIER();
+    _head = head + 1;
+    return true;
+  }
+
+  /**
+   * @fn push
+   * @brief Producer side: store the last measured data of a sensor with its timestamp
+   * @param sensor the sensor that just finished a measurement read
+   * @return true means the sample is stored
+   */
+  bool push(DFRobot_RS01 &sensor)
+  {
+    uint8_t head = _head;
+    if((uint8_t)(head - _tail) >= Capacity){
+      _dropped++;
+      return false;
+    }
+    sensor.getSample(&_buf[head & (Capacity - 1)]);   // Fill the slot in place, no intermediate copy
+    RS01_MEMORY_BARRIER();
+    _head = head + 1;
+    return true;
+  }
+
+  /**
+   * @fn pop
+   * @brief Consumer side: take the oldest sample
+   * @param sample where to copy the sample
+   * @return true means a sample was taken, false means the ring is empty
+   */
+  bool pop(DFRobot_RS01::sSample_t &sample)
+  {
+    return 1 == popBatch(&sample, 1);
+  }
+
+  /**
+   * @fn popBatch
+   * @brief Consumer side: take up to maxCount of the oldest samples at once
+   * @param pBuf where to copy the samples
+   * @param maxCount the size of pBuf in samples
+   * @return uint8_t, the number of samples taken
+   */
+  uint8_t popBatch(DFRobot_RS01::sSample_t *pBuf, uint8_t maxCount)
+  {
+    uint8_t tail = _tail;
+    uint8_t count = (uint8_t)(_head - tail);
+    RS01_MEMORY_BARRIER();
+    if(count > maxCount){
+      count = maxCount;
+    }
+    for(uint8_t i = 0; i < count; i++){
+      pBuf[i] = _buf[(uint8_t)(tail + i) & (Capacity - 1)];
+    }
+    RS01_MEMORY_BARRIER();
+    _tail = tail + count;
+    return count;
+  }
+
+  /**
+   * @fn available
+   * @brief Get the number of samples waiting to be taken
+   * @return uint8_t, 0~Capacity
+   */
+  uint8_t available(void) const
+  {
+    return (uint8_t)(_head - _tail);
+  }
+
+  /**
+   * @fn getDropped
+   * @brief Get the number of samples dropped because the ring was full
+   * @return uint32_t, dropped samples since construction
+   */
+  uint32_t getDropped(void) const
+  {
+    return _dropped;
+  }
+
+private:
+  DFRobot_RS01::sSample_t _buf[Capacity];   // sample slots
+  volatile uint8_t _head;   // free-running write index, written by the producer only
+  volatile uint8_t _tail;   // free-running read index, written by the consumer only
+  volatile uint32_t _dropped;   // samples dropped on a full ring, written by the producer only
+};
+
+#endif
@@ -0,0 +1,61 @@
+/*!
+ * @file  DFRobot_RS01Stage.h
+ * @brief  Define infrastructure of DFRobot_RS01Stage class
+ * @details  Processing stages run on every fresh measurement, attached to a sensor with DFRobot_RS01::setStage()
+ * @n        and chained with setNext(), e.g. a filter followed by a tracker
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_STAGE_H__
+#define __DFROBOT_RS01_STAGE_H__
+
+#include "DFRobot_RS01.h"
+
+/**
+ * @brief Base of the measurement processing stages
+ */
+class DFRobot_RS01Stage
+{
+public:
+  DFRobot_RS01Stage(void) : _next(NULL) {}
+
+  /**
+   * @fn process
+   * @brief Called by the sensor with every fresh measurement, in the order of the chain
+   * @param sensor the sensor that received the frame
+   * @param measurement the measured data, a stage may modify it in place for the stages behind it and the user
+   * @return None
+   */
+  virtual void process(DFRobot_RS01 &sensor, DFRobot_RS01::sMeasurement_t &measurement) = 0;
+
+  /**
+   * @fn reset
+   * @brief Forget the history accumulated from earlier measurements
+   * @return None
+   */
+  virtual void reset(void) {}
+
+  /**
+   * @fn setNext
+   * @brief Chain another stage behind this one
+   * @param next the stage run after this one, NULL to end the chain here
+   * @return None
+   */
+  void setNext(DFRobot_RS01Stage *next) { _next = next; }
+
+  /**
+   * @fn getNext
+   * @brief Get the stage chained behind this one
+   * @return DFRobot_RS01Stage *, NULL at the end of the chain
+   */
+  DFRobot_RS01Stage *getNext(void) const { return _next; }
+
+private:
+  DFRobot_RS01Stage *_next;   // the next stage of the chain
+};
+
+#endif
@@ -0,0 +1,144 @@
+/*!
+ * @file  DFRobot_RS01Sweep.cpp
+ * @brief  Define the infrastructure DFRobot_RS01Sweep class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01Sweep.h"
+
+DFRobot_RS01Sweep::DFRobot_RS01Sweep(void)
+{
+  _count = 0;
+  _transportCount = 0;
+  _pending = 0;
+  _periodMs = 0;
+  _sweepStartMs = 0;
+  _sweepStartUs = 0;
+  _sweepUs = 0;
+  _started = false;
+  _sweepCallback = NULL;
+}
+
+int DFRobot_RS01Sweep::addSensor(DFRobot_RS01 *sensor)
+{
+  if((NULL == sensor) || (NULL == sensor->getTransport())){
+    DBG("ERR_NO_TRANSPORT");
+    return ERR_NO_TRANSPORT;
+  }
+
+  DFRobot_RS01Transport *transport = sensor->getTransport();
+  uint8_t t = 0;
+  while((t < _transportCount) && (_transports[t] != transport)){
+    t++;
+  }
+  if((RS01_SWEEP_MAX_SENSORS <= _count) || (RS01_SWEEP_MAX_TRANSPORTS <= t)){
+    DBG("ERR_SWEEP_FULL");
+    return ERR_SWEEP_FULL;
+  }
+  if(t == _transportCount){
+    _transports[_transportCount++] = transport;
+  }
+
+  _pendingFlags[_count] = false;
+  _sensors[_count] = sensor;
+  return _count++;
+}
+
+void DFRobot_RS01Sweep::setPeriod(uint32_t ms)
+{
+  _periodMs = ms;
+}
+
+void DFRobot_RS01Sweep::setSweepCallback(sweepCallback_t callback)
+{
+  _sweepCallback = callback;
+}
+
+uint8_t DFRobot_RS01Sweep::startSweep(void)
+{
+  _sweepStartMs = millis();
+  _sweepStartUs = micros();
+  _started = true;
+  for(uint8_t i = 0; i < _count; i++){
+    if(_pendingFlags[i]){
+      continue;
+    }
+    int ret = _sensors[i]->startMeasurementRead();   // Only queued here, nothing waits
+    if(0 == ret){
+      _pendingFlags[i] = true;
+      _pending++;
+    }else if(_sweepCallback){
+      _sweepCallback(i, _sensors[i], (uint8_t)ret);
+    }
+  }
+  return _pending;
+}
+
+bool DFRobot_RS01Sweep::poll(void)
+{
+  if((0 == _pending) && (!_started || ((millis() - _sweepStartMs) >= _periodMs))){
+    startSweep();
+  }
+  if(0 == _pending){
+    return false;
+  }
+
+  for(uint8_t t = 0; t < _transportCount; t++){   // Every gateway moves forward, none waits for another
+    _transports[t]->service();
+  }
+
+  uint8_t done[RS01_SWEEP_MAX_SENSORS];   // Sensors completed since the last call, in completion order
+  uint8_t doneCount = 0;
+  for(uint8_t i = 0; i < _count; i++){
+    if(!_pendingFlags[i] || (DFRobot_RS01::eAsyncWaitResponse == _sensors[i]->getAsyncState())){
+      continue;   // The transports completed it or not, poll() would service them again
+    }
+    uint32_t at = _sensors[i]->getAsyncDoneUs() - _sweepStartUs;
+    uint8_t j = doneCount++;
+    while((j > 0) && ((_sensors[done[j - 1]]->getAsyncDoneUs() - _sweepStartUs) > at)){
+      done[j] = done[j - 1];
+      j--;
+    }
+    done[j] = i;
+  }
+
+  for(uint8_t k = 0; k < doneCount; k++){
+    uint8_t i = done[k];
+    _pendingFlags[i] = false;
+    _pending--;
+    uint8_t ret = (DFRobot_RS01::eAsyncDone == _sensors[i]->getAsyncState()) ? 0 : _sensors[i]->getAsyncError();
+    if(_sweepCallback){
+      _sweepCallback(i, _sensors[i], ret);
+    }
+  }
+
+  if(0 == _pending){
+    _sweepUs = micros() - _sweepStartUs;
+    return true;
+  }
+  return false;
+}
+
+bool DFRobot_RS01Sweep::isSweepDone(void)
+{
+  return 0 == _pending;
+}
+
+uint32_t DFRobot_RS01Sweep::getSweepUs(void)
+{
+  return _sweepUs;
+}
+
+uint8_t DFRobot_RS01Sweep::getSensorCount(void)
+{
+  return _count;
+}
+
+DFRobot_RS01 *DFRobot_RS01Sweep::getSensor(uint8_t index)
+{
+  return (index < _count) ? _sensors[index] : NULL;
+}
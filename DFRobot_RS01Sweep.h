@@ -0,0 +1,136 @@
+/*!
+ * @file  DFRobot_RS01Sweep.h
+ * @brief  Define infrastructure of DFRobot_RS01Sweep class
+ * @details  Pipelined sweep over sensors behind one or more transports: the measurement reads of all sensors
+ * @n        are submitted at once, so a sweep takes about the slowest round trip of a gateway instead of the sum of them
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_SWEEP_H__
+#define __DFROBOT_RS01_SWEEP_H__
+
+#include "DFRobot_RS01.h"
+
+#ifndef RS01_SWEEP_MAX_SENSORS
+  #define RS01_SWEEP_MAX_SENSORS      32     ///< sensors one sweep can hold, define it before including this file to change it
+#endif
+#ifndef RS01_SWEEP_MAX_TRANSPORTS
+  #define RS01_SWEEP_MAX_TRANSPORTS   8      ///< distinct transports(gateways) one sweep can drive
+#endif
+
+#define ERR_SWEEP_FULL    (-3)   ///< no free sensor or transport slot
+#define ERR_NO_TRANSPORT  (-4)   ///< the sensor wasn't initialized with begin(DFRobot_RS01Transport *)
+
+class DFRobot_RS01Sweep
+{
+public:
+  /**
+   * @brief Called from poll() for every read completed since the last poll(), in completion order,
+   * @n     and from startSweep() for a sensor whose read couldn't be submitted
+   * @param index index of the sensor returned by addSensor()
+   * @param sensor the sensor, its measurement holds the new frame when ret is 0
+   * @param ret 0 means read succeeds, otherwise the RTU exception code
+   */
+  typedef void (*sweepCallback_t)(uint8_t index, DFRobot_RS01 *sensor, uint8_t ret);
+
+  /**
+   * @fn DFRobot_RS01Sweep
+   * @brief constructor
+   * @return None
+   */
+  DFRobot_RS01Sweep(void);
+
+  /**
+   * @fn addSensor
+   * @brief Register a sensor, it must have been initialized with begin(DFRobot_RS01Transport *)
+   * @n     Sensors sharing a transport are pipelined on it, different transports run in parallel
+   * @param sensor the sensor
+   * @return int type, index of the sensor
+   * @retval >=0 index of the sensor
+   * @retval -3 ERR_SWEEP_FULL
+   * @retval -4 ERR_NO_TRANSPORT
+   */
+  int addSensor(DFRobot_RS01 *sensor);
+
+  /**
+   * @fn setPeriod
+   * @brief Start a new sweep from poll() once this time has passed since the previous one started
+   * @param ms sweep period, 0(default) starts the next sweep as soon as one completes
+   * @return None
+   */
+  void setPeriod(uint32_t ms);
+
+  /**
+   * @fn setSweepCallback
+   * @brief Set the function called for every completed read
+   * @param callback the callback, NULL to disable
+   * @return None
+   */
+  void setSweepCallback(sweepCallback_t callback);
+
+  /**
+   * @fn startSweep
+   * @brief Submit the measurement read of every sensor, a sensor still busy from the previous sweep is skipped
+   * @n     A sensor refusing the read(busy elsewhere, open circuit breaker, full queue) is reported to the callback at once
+   * @return uint8_t, the number of reads outstanding
+   */
+  uint8_t startSweep(void);
+
+  /**
+   * @fn poll
+   * @brief Service every transport once, deliver the completed reads and start the next sweep when due
+   * @n     The sensors are only checked, not polled, so no transport is serviced twice; the call doesn't block
+   * @n     unless the transport does(DFRobot_RS01RTUTransport runs one round trip per service())
+   * @return true means a sweep completed in this call
+   */
+  bool poll(void);
+
+  /**
+   * @fn isSweepDone
+   * @brief Check whether every read of the current sweep has completed
+   * @return true means done
+   */
+  bool isSweepDone(void);
+
+  /**
+   * @fn getSweepUs
+   * @brief Get the duration of the last complete sweep
+   * @return uint32_t, from startSweep() to the last completion in us
+   */
+  uint32_t getSweepUs(void);
+
+  /**
+   * @fn getSensorCount
+   * @brief Get the number of registered sensors
+   * @return uint8_t, the number of registered sensors
+   */
+  uint8_t getSensorCount(void);
+
+  /**
+   * @fn getSensor
+   * @brief Get a registered sensor
+   * @param index index returned by addSensor()
+   * @return DFRobot_RS01 pointer, NULL if the index is out of range
+   */
+  DFRobot_RS01 *getSensor(uint8_t index);
+
+private:
+  DFRobot_RS01 *_sensors[RS01_SWEEP_MAX_SENSORS];   // registered sensors
+  DFRobot_RS01Transport *_transports[RS01_SWEEP_MAX_TRANSPORTS];   // distinct transports of the sensors
+  uint8_t _count;   // registered sensors
+  uint8_t _transportCount;   // distinct transports
+  uint8_t _pending;   // reads of the current sweep still outstanding
+  bool _pendingFlags[RS01_SWEEP_MAX_SENSORS];   // sensors whose read is outstanding
+  uint32_t _periodMs;   // sweep period, 0 back to back
+  uint32_t _sweepStartMs;   // millis() at the start of the current sweep
+  uint32_t _sweepStartUs;   // micros() at the start of the current sweep
+  uint32_t _sweepUs;   // duration of the last complete sweep
+  bool _started;   // a sweep has been started
+  sweepCallback_t _sweepCallback;   // completion callback
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*!
+ * @file  DFRobot_RS01TCPTransport.cpp
+ * @brief  Define the infrastructure DFRobot_RS01TCPTransport class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01TCPTransport.h"
+#include "DFRobot_RS01.h"
+
+DFRobot_RS01TCPTransport::DFRobot_RS01TCPTransport(Client *client, uint8_t maxInFlight)
+  : _client(client)
+{
+  _maxInFlight = ((0 == maxInFlight) || (RS01_TCP_MAX_INFLIGHT < maxInFlight)) ? RS01_TCP_MAX_INFLIGHT : maxInFlight;
+  _nextTid = 1;
+  _rxLen = 0;
+  _rxDiscard = 0;
+  for(uint8_t i = 0; i < RS01_TCP_MAX_INFLIGHT; i++){
+    _slots[i].t = NULL;
+  }
+}
+
+bool DFRobot_RS01TCPTransport::isIdle(void)
+{
+  for(uint8_t i = 0; i < _maxInFlight; i++){
+    if(_slots[i].t){
+      return false;
+    }
+  }
+  return DFRobot_RS01Transport::isIdle();
+}
+
+void DFRobot_RS01TCPTransport::service(void)
+{
+  if(!_client->connected()){
+    failAll(DFRobot_RTU::eRTU_RECV_ERROR);
+    sTransaction_t *t;
+    while(NULL != (t = dequeue())){
+      complete(t, DFRobot_RTU::eRTU_RECV_ERROR);
+    }
+    return;
+  }
+
+  receive();
+
+  /* Fill the free slots from the queue, all requests go out back to back */
+  for(uint8_t i = 0; i < _maxInFlight; i++){
+    if(_slots[i].t){
+      continue;
+    }
+    sTransaction_t *t = dequeue();
+    if(NULL == t){
+      break;
+    }
+    uint8_t frame[RS01_TCP_MBAP_BYTES + 6 + 2 * RS01_TRANSPORT_MAX_REGS];
+    uint8_t len = buildPDU(t, &frame[RS01_TCP_MBAP_BYTES]);
+    uint16_t tid = _nextTid++;
+    frame[0] = (uint8_t)(tid >> 8);
+    frame[1] = (uint8_t)(tid & 0xFF);
+    frame[2] = 0x00;   // Protocol ID: modbus
+    frame[3] = 0x00;
+    frame[4] = 0x00;
+    frame[5] = len + 1;   // Unit ID with the PDU
+    frame[6] = t->addr;
+    size_t size = RS01_TCP_MBAP_BYTES + len;
+    if(size != _client->write(frame, size)){
+      complete(t, DFRobot_RTU::eRTU_RECV_ERROR);
+      continue;
+    }
+    if(0 == t->addr){
+      complete(t, 0);   // The gateway forwards a broadcast without a response
+      continue;
+    }
+    _slots[i].t = t;
+    _slots[i].tid = tid;
+    _slots[i].sentMs = millis();
+  }
+
+  for(uint8_t i = 0; i < _maxInFlight; i++){
+    if(_slots[i].t && ((millis() - _slots[i].sentMs) > timeoutOf(_slots[i].t))){
+      sTransaction_t *t = _slots[i].t;
+      _slots[i].t = NULL;
+      complete(t, DFRobot_RTU::eRTU_RECV_ERROR);
+    }
+  }
+}
+
+void DFRobot_RS01TCPTransport::receive(void)
+{
+  int avail;
+  while((avail = _client->available()) > 0){
+    if(_rxDiscard){   // Skip the rest of a response nobody waits for
+      _client->read();
+      _rxDiscard--;
+      continue;
+    }
+
+    uint8_t want = (_rxLen < RS01_TCP_MBAP_BYTES) ? (RS01_TCP_MBAP_BYTES - _rxLen) :
+                   (RS01_TCP_MBAP_BYTES - 1 + _rxBuf[5] - _rxLen);
+    int n = _client->read(&_rxBuf[_rxLen], (avail < want) ? avail : want);
+    if(n <= 0){
+      return;
+    }
+    _rxLen += n;
+
+    if(RS01_TCP_MBAP_BYTES == _rxLen){
+      uint16_t length = ((uint16_t)_rxBuf[4] << 8) | _rxBuf[5];
+      if((length < 2) || ((size_t)(RS01_TCP_MBAP_BYTES - 1 + length) > sizeof(_rxBuf))){
+        _rxDiscard = (length > 1) ? (length - 1) : 0;   // Can't be ours, keep the stream aligned
+        _rxLen = 0;
+        continue;
+      }
+    }
+    if((_rxLen < RS01_TCP_MBAP_BYTES) || (_rxLen < (RS01_TCP_MBAP_BYTES - 1 + _rxBuf[5]))){
+      continue;
+    }
+
+    uint16_t tid = ((uint16_t)_rxBuf[0] << 8) | _rxBuf[1];
+    for(uint8_t i = 0; i < _maxInFlight; i++){   // Responses may come back in any order
+      if(_slots[i].t && (tid == _slots[i].tid)){
+        sTransaction_t *t = _slots[i].t;
+        _slots[i].t = NULL;
+        uint8_t ret = (_rxBuf[6] == t->addr) ? parsePDU(t, &_rxBuf[RS01_TCP_MBAP_BYTES], _rxLen - RS01_TCP_MBAP_BYTES) :
+                                               (uint8_t)DFRobot_RTU::eRTU_ID_ERROR;
+        complete(t, ret);
+        break;
+      }
+    }
+    _rxLen = 0;
+  }
+}
+
+void DFRobot_RS01TCPTransport::failAll(uint8_t ret)
+{
+  for(uint8_t i = 0; i < _maxInFlight; i++){
+    if(_slots[i].t){
+      sTransaction_t *t = _slots[i].t;
+      _slots[i].t = NULL;
+      complete(t, ret);
+    }
+  }
+  _rxLen = 0;
+  _rxDiscard = 0;
+}
@@ -0,0 +1,72 @@
+/*!
+ * @file  DFRobot_RS01TCPTransport.h
+ * @brief  Define infrastructure of DFRobot_RS01TCPTransport class
+ * @details  Modbus-TCP backend for RS485-to-Ethernet gateways, several transaction IDs are kept in flight at once
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_TCP_TRANSPORT_H__
+#define __DFROBOT_RS01_TCP_TRANSPORT_H__
+
+#include <Client.h>
+#include "DFRobot_RS01Transport.h"
+
+#ifndef RS01_TCP_MAX_INFLIGHT
+  #define RS01_TCP_MAX_INFLIGHT       4      ///< transactions outstanding at once, define it before including this file to change it
+#endif
+#define RS01_TCP_MBAP_BYTES           7      ///< MBAP header: transaction ID, protocol ID, length, unit ID
+
+class DFRobot_RS01TCPTransport : public DFRobot_RS01Transport
+{
+public:
+  /**
+   * @fn DFRobot_RS01TCPTransport
+   * @brief constructor
+   * @param client connected TCP client of the gateway(EthernetClient, WiFiClient...), reconnecting is left to the user
+   * @param maxInFlight transactions sent before the oldest response is back, 1~RS01_TCP_MAX_INFLIGHT,
+   * @n     gateways serialise the RS485 side, pipelining hides the network round trip
+   * @return None
+   */
+  DFRobot_RS01TCPTransport(Client *client, uint8_t maxInFlight = RS01_TCP_MAX_INFLIGHT);
+
+  void service(void);
+  bool isIdle(void);
+
+private:
+  /* one outstanding request */
+  typedef struct
+  {
+    sTransaction_t *t;   // the transaction, NULL when the slot is free
+    uint16_t tid;   // its MBAP transaction ID
+    uint32_t sentMs;   // time the request was sent
+  }sSlot_t;
+
+  /**
+   * @fn failAll
+   * @brief Complete everything in flight with an error, e.g. when the connection dropped
+   * @param ret the error
+   * @return None
+   */
+  void failAll(uint8_t ret);
+
+  /**
+   * @fn receive
+   * @brief Collect the bytes available and dispatch every complete response
+   * @return None
+   */
+  void receive(void);
+
+  Client *_client;   // connection to the gateway
+  uint8_t _maxInFlight;   // outstanding requests allowed
+  uint16_t _nextTid;   // transaction ID of the next request
+  sSlot_t _slots[RS01_TCP_MAX_INFLIGHT];   // outstanding requests
+  uint8_t _rxLen;   // bytes collected into _rxBuf
+  uint8_t _rxBuf[RS01_TCP_MBAP_BYTES + 2 + 2 * RS01_TRANSPORT_MAX_REGS];   // response being collected
+  uint16_t _rxDiscard;   // bytes of an oversized or unknown response still to skip
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*!
+ * @file  DFRobot_RS01Tracker.cpp
+ * @brief  Define the infrastructure DFRobot_RS01Tracker class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01Tracker.h"
+
+DFRobot_RS01Tracker::DFRobot_RS01Tracker(void)
+{
+  _gate = RS01_TRACKER_DEFAULT_GATE;
+  _hold = RS01_TRACKER_DEFAULT_HOLD;
+  _trackCallback = NULL;
+  _nextId = 1;
+  _count = 0;
+}
+
+void DFRobot_RS01Tracker::setGate(uint16_t gate)
+{
+  _gate = gate;
+}
+
+void DFRobot_RS01Tracker::setHold(uint8_t frames)
+{
+  _hold = frames;
+}
+
+void DFRobot_RS01Tracker::setTrackCallback(trackCallback_t callback)
+{
+  _trackCallback = callback;
+}
+
+uint8_t DFRobot_RS01Tracker::getTrackCount(void) const
+{
+  return _count;
+}
+
+const DFRobot_RS01Tracker::sTrack_t *DFRobot_RS01Tracker::getTrack(uint8_t index) const
+{
+  return (index < _count) ? &_tracks[index] : NULL;
+}
+
+const DFRobot_RS01Tracker::sTrack_t *DFRobot_RS01Tracker::findTrack(uint8_t id) const
+{
+  for(uint8_t i = 0; i < _count; i++){
+    if(id == _tracks[i].id){
+      return &_tracks[i];
+    }
+  }
+  return NULL;
+}
+
+void DFRobot_RS01Tracker::reset(void)
+{
+  _count = 0;   // Forget silently, the leave events of a reset aren't meaningful
+}
+
+void DFRobot_RS01Tracker::process(DFRobot_RS01 &sensor, DFRobot_RS01::sMeasurement_t &measurement)
+{
+  uint32_t now = sensor.getSampleTimestamp();
+  uint8_t targets = measurement.targetCount;
+  uint8_t tracks = _count;
+  int8_t trackOf[5] = {-1, -1, -1, -1, -1};   // track matched to every target
+  bool matched[RS01_TRACKER_MAX_TRACKS] = {false};
+
+  /* Greedy association: take the closest free track/target pair within the gate until none is left */
+  for(;;){
+    uint16_t best = _gate;
+    int8_t bestTrack = -1;
+    int8_t bestTarget = -1;
+    for(uint8_t t = 0; t < tracks; t++){
+      if(matched[t]){
+        continue;
+      }
+      for(uint8_t m = 0; m < targets; m++){
+        if(0 <= trackOf[m]){
+          continue;
+        }
+        uint16_t d = (measurement.distance[m] > _tracks[t].distance) ?
+                     (measurement.distance[m] - _tracks[t].distance) : (_tracks[t].distance - measurement.distance[m]);
+        if(d <= best){
+          best = d;
+          bestTrack = t;
+          bestTarget = m;
+        }
+      }
+    }
+    if(bestTrack < 0){
+      break;
+    }
+    matched[bestTrack] = true;
+    trackOf[bestTarget] = bestTrack;
+  }
+
+  for(uint8_t t = 0; t < tracks; t++){
+    if(!matched[t]){
+      _tracks[t].misses++;
+    }
+  }
+
+  for(uint8_t m = 0; m < targets; m++){
+    if(0 <= trackOf[m]){   // Seen again: update the position and the velocity
+      sTrack_t &track = _tracks[trackOf[m]];
+      uint32_t dt = (now - track.lastSeenUs) >> 6;   // In 64us units: 1s = 15625, the product stays within 32 bits
+      if(dt){
+        int32_t v = ((int32_t)measurement.distance[m] - (int32_t)track.distance) * 15625 / (int32_t)dt;
+        v = (v + track.velocity) / 2;   // Smooth out the quantisation of the distance
+        track.velocity = (v > 32767) ? 32767 : ((v < -32767) ? -32767 : (int16_t)v);
+      }
+      track.distance = measurement.distance[m];
+      track.intensity = measurement.intensity[m];
+      track.lastSeenUs = now;
+      track.misses = 0;
+    }else if(RS01_TRACKER_MAX_TRACKS > _count){   // Not seen before: a new track enters
+      sTrack_t &track = _tracks[_count++];
+      track.id = _nextId;
+      _nextId = (255 == _nextId) ? 1 : (_nextId + 1);
+      track.misses = 0;
+      track.distance = measurement.distance[m];
+      track.intensity = measurement.intensity[m];
+      track.velocity = 0;
+      track.lastSeenUs = now;
+      if(_trackCallback){
+        _trackCallback(&track, eTrackEnter);
+      }
+    }
+  }
+
+  for(uint8_t t = tracks; t > 0; t--){   // Backwards, removing shifts the tracks behind
+    if(_tracks[t - 1].misses > _hold){
+      removeTrack(t - 1);
+    }
+  }
+
+  for(uint8_t i = 1; i < _count; i++){   // Keep the nearest first, the list is almost sorted already
+    sTrack_t track = _tracks[i];
+    uint8_t j = i;
+    while(j && (_tracks[j - 1].distance > track.distance)){
+      _tracks[j] = _tracks[j - 1];
+      j--;
+    }
+    _tracks[j] = track;
+  }
+}
+
+void DFRobot_RS01Tracker::removeTrack(uint8_t index)
+{
+  if(_trackCallback){
+    _trackCallback(&_tracks[index], eTrackLeave);
+  }
+  _count--;
+  for(uint8_t i = index; i < _count; i++){
+    _tracks[i] = _tracks[i + 1];
+  }
+}
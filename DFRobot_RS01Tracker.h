@@ -0,0 +1,130 @@
+/*!
+ * @file  DFRobot_RS01Tracker.h
+ * @brief  Define infrastructure of DFRobot_RS01Tracker class
+ * @details  Processing stage following the targets across frames: persistent IDs, velocity and enter/leave events
+ * @n        from greedy nearest-distance association over fixed-size arrays
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_TRACKER_H__
+#define __DFROBOT_RS01_TRACKER_H__
+
+#include "DFRobot_RS01Stage.h"
+
+#define RS01_TRACKER_MAX_TRACKS       5      ///< tracks followed at the same time, a frame reports at most 5 targets
+#define RS01_TRACKER_DEFAULT_GATE     100    ///< default largest distance change between frames still taken for the same target
+#define RS01_TRACKER_DEFAULT_HOLD     3      ///< default frames a track may miss before it leaves
+
+class DFRobot_RS01Tracker : public DFRobot_RS01Stage
+{
+public:
+  /**
+   * @struct sTrack_t
+   * @brief One target followed across frames
+   */
+  typedef struct
+  {
+    uint8_t id;   /**< persistent ID, 1~255, reused only after wrapping around */
+    uint8_t misses;   /**< consecutive frames the target wasn't seen in */
+    uint16_t distance;   /**< last measured distance */
+    uint16_t intensity;   /**< last measured intensity */
+    int16_t velocity;   /**< distance change per second, positive moving away, smoothed over a few frames */
+    uint32_t lastSeenUs;   /**< micros() of the frame the target was last seen in */
+  }sTrack_t;
+
+  /**
+   * @enum eTrackEvent_t
+   * @brief Track events
+   */
+  typedef enum
+  {
+    eTrackEnter = 0,   /**< a new target got an ID */
+    eTrackLeave,   /**< a target missed more frames than the hold allows, the ID is retired */
+  }eTrackEvent_t;
+
+  /**
+   * @brief Called from refreshMeasurementData()/poll() when a track enters or leaves
+   * @param track the track
+   * @param event eTrackEnter or eTrackLeave
+   */
+  typedef void (*trackCallback_t)(const sTrack_t *track, eTrackEvent_t event);
+
+  /**
+   * @fn DFRobot_RS01Tracker
+   * @brief constructor
+   * @return None
+   */
+  DFRobot_RS01Tracker(void);
+
+  /**
+   * @fn setGate
+   * @brief Set the largest distance change between two frames still taken for the same target
+   * @param gate distance, the default is RS01_TRACKER_DEFAULT_GATE
+   * @return None
+   */
+  void setGate(uint16_t gate);
+
+  /**
+   * @fn setHold
+   * @brief Set the frames a track may miss before it leaves, bridging short dropouts
+   * @param frames 0 makes a track leave in the first frame without it
+   * @return None
+   */
+  void setHold(uint8_t frames);
+
+  /**
+   * @fn setTrackCallback
+   * @brief Set the callback of the enter/leave events
+   * @param callback the callback, NULL for none
+   * @return None
+   */
+  void setTrackCallback(trackCallback_t callback);
+
+  /**
+   * @fn getTrackCount
+   * @brief Get the number of tracks currently followed, including the ones in their hold time
+   * @return uint8_t, 0~RS01_TRACKER_MAX_TRACKS
+   */
+  uint8_t getTrackCount(void) const;
+
+  /**
+   * @fn getTrack
+   * @brief Get a track currently followed
+   * @param index 0~getTrackCount()-1, nearest first
+   * @return const sTrack_t *, NULL if index is out of range
+   */
+  const sTrack_t *getTrack(uint8_t index) const;
+
+  /**
+   * @fn findTrack
+   * @brief Look a track up by its ID
+   * @param id the ID
+   * @return const sTrack_t *, NULL if no track has this ID
+   */
+  const sTrack_t *findTrack(uint8_t id) const;
+
+  void process(DFRobot_RS01 &sensor, DFRobot_RS01::sMeasurement_t &measurement);
+  void reset(void);
+
+private:
+  /**
+   * @fn removeTrack
+   * @brief Retire a track and report it
+   * @param index index into _tracks
+   * @return None
+   */
+  void removeTrack(uint8_t index);
+
+  sTrack_t _tracks[RS01_TRACKER_MAX_TRACKS];   // followed tracks, nearest first
+  uint8_t _count;   // tracks in _tracks
+  uint8_t _nextId;   // ID the next new target gets
+  uint16_t _gate;   // largest distance change of the same target between frames
+  uint8_t _hold;   // frames a track may miss
+  trackCallback_t _trackCallback;   // enter/leave callback
+};
+
+#endif
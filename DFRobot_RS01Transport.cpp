@@ -0,0 +1,181 @@
+/*!
+ * @file  DFRobot_RS01Transport.cpp
+ * @brief  Define the infrastructure DFRobot_RS01Transport class
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include "DFRobot_RS01Transport.h"
+#include "DFRobot_RS01.h"
+
+DFRobot_RS01Transport::DFRobot_RS01Transport(void)
+{
+  _timeoutMs = RS01_TRANSPORT_TIMEOUT_MS;
+  _head = NULL;
+  _tail = NULL;
+}
+
+bool DFRobot_RS01Transport::submit(sTransaction_t *t)
+{
+  if((NULL == t) || (eTransactionPending == t->state) || (0 == t->count) || (RS01_TRANSPORT_MAX_REGS < t->count) ||
+     ((0x03 != t->function) && (0x10 != t->function)) || ((0 == t->addr) && (0x10 != t->function))){
+    DBG("transaction refused");
+    return false;
+  }
+  t->state = eTransactionPending;
+  t->ret = 0;
+  t->next = NULL;
+  if(_tail){
+    _tail->next = t;
+  }else{
+    _head = t;
+  }
+  _tail = t;
+  return true;
+}
+
+void DFRobot_RS01Transport::setTimeout(uint32_t ms)
+{
+  _timeoutMs = ms;
+}
+
+uint32_t DFRobot_RS01Transport::getTimeout(void)
+{
+  return _timeoutMs;
+}
+
+uint32_t DFRobot_RS01Transport::timeoutOf(const sTransaction_t *t)
+{
+  return t->timeoutMs ? t->timeoutMs : _timeoutMs;
+}
+
+uint8_t DFRobot_RS01Transport::transfer(sTransaction_t *t)
+{
+  if(!submit(t)){
+    return DFRobot_RTU::eRTU_MEMORY_ERROR;
+  }
+  while(eTransactionPending == t->state){
+    service();
+    yield();
+  }
+  return t->ret;
+}
+
+bool DFRobot_RS01Transport::isIdle(void)
+{
+  return NULL == _head;
+}
+
+DFRobot_RS01Transport::sTransaction_t *DFRobot_RS01Transport::dequeue(void)
+{
+  sTransaction_t *t = _head;
+  if(t){
+    _head = t->next;
+    if(NULL == _head){
+      _tail = NULL;
+    }
+    t->next = NULL;
+  }
+  return t;
+}
+
+void DFRobot_RS01Transport::complete(sTransaction_t *t, uint8_t ret)
+{
+  t->ret = ret;
+  t->state = eTransactionDone;
+  if(ret){
+    DBG(ret);
+  }
+  if(t->callback){
+    t->callback(t);
+  }
+}
+
+uint8_t DFRobot_RS01Transport::buildPDU(const sTransaction_t *t, uint8_t *pdu)
+{
+  pdu[0] = t->function;
+  pdu[1] = (uint8_t)(t->reg >> 8);
+  pdu[2] = (uint8_t)(t->reg & 0xFF);
+  pdu[3] = 0x00;
+  pdu[4] = t->count;
+  if(0x03 == t->function){
+    return 5;
+  }
+  pdu[5] = 2 * t->count;
+  for(uint8_t i = 0; i < t->count; i++){
+    pdu[6 + 2 * i] = (uint8_t)(t->pBuf[i] >> 8);
+    pdu[7 + 2 * i] = (uint8_t)(t->pBuf[i] & 0xFF);
+  }
+  return 6 + 2 * t->count;
+}
+
+uint8_t DFRobot_RS01Transport::parsePDU(sTransaction_t *t, const uint8_t *pdu, uint8_t len)
+{
+  if((2 == len) && ((t->function | 0x80) == pdu[0])){   // Exception response: function | 0x80, code
+    return pdu[1];
+  }
+  if(t->function != pdu[0]){
+    return DFRobot_RTU::eRTU_RECV_ERROR;
+  }
+  if(0x03 == t->function){
+    if((len != (2 + 2 * t->count)) || (pdu[1] != (2 * t->count))){
+      return DFRobot_RTU::eRTU_RECV_ERROR;
+    }
+    for(uint8_t i = 0; i < t->count; i++){
+      t->pBuf[i] = ((uint16_t)pdu[2 + 2 * i] << 8) | pdu[3 + 2 * i];
+    }
+    return 0;
+  }
+  if((5 != len) || (((uint16_t)pdu[1] << 8 | pdu[2]) != t->reg) || (((uint16_t)pdu[3] << 8 | pdu[4]) != t->count)){
+    return DFRobot_RTU::eRTU_RECV_ERROR;   // The write response echoes the address and the count
+  }
+  return 0;
+}
+
+DFRobot_RS01RTUTransport::DFRobot_RS01RTUTransport(DFRobot_RTU *rtu, Stream *_serial)
+  : _rtu(rtu), _stream(_serial)
+{
+  _rtu->setTimeoutTimeMs(_timeoutMs);
+}
+
+void DFRobot_RS01RTUTransport::service(void)
+{
+  sTransaction_t *t = dequeue();
+  if(NULL == t){
+    return;
+  }
+
+  uint8_t ret;
+  if(0 == t->addr){   // DFRobot_RTU waits for a response nobody sends, put the frame out directly
+    if(NULL == _stream){
+      ret = DFRobot_RTU::eRTU_ID_ERROR;
+    }else{
+      uint8_t frame[1 + 6 + 2 * RS01_TRANSPORT_MAX_REGS + 2];
+      frame[0] = 0;
+      uint8_t len = 1 + buildPDU(t, &frame[1]);
+      uint16_t crc = DFRobot_RS01::calculateCRC16(frame, len);
+      frame[len++] = (uint8_t)(crc & 0xFF);
+      frame[len++] = (uint8_t)(crc >> 8);
+      _stream->write(frame, len);
+      _stream->flush();
+      ret = 0;
+    }
+  }else{
+    _rtu->setTimeoutTimeMs(timeoutOf(t));   // Sensors sharing the transport may each have their own
+    if(0x03 == t->function){
+      ret = _rtu->readHoldingRegister(t->addr, t->reg, t->pBuf, t->count);
+    }else{
+      ret = _rtu->writeHoldingRegister(t->addr, t->reg, t->pBuf, t->count);
+    }
+  }
+  complete(t, ret);
+}
+
+void DFRobot_RS01RTUTransport::setTimeout(uint32_t ms)
+{
+  DFRobot_RS01Transport::setTimeout(ms);
+  _rtu->setTimeoutTimeMs(ms);
+}
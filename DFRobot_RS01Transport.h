@@ -0,0 +1,184 @@
+/*!
+ * @file  DFRobot_RS01Transport.h
+ * @brief  Define infrastructure of DFRobot_RS01Transport class
+ * @details  Pluggable modbus transport with queued, asynchronous submit/complete semantics,
+ * @n        and the DFRobot_RS01RTUTransport backend over the DFRobot_RTU library
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author  [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url  https://github.com/DFRobot/DFRobot_RS01
+ */
+#ifndef __DFROBOT_RS01_TRANSPORT_H__
+#define __DFROBOT_RS01_TRANSPORT_H__
+
+#include <Arduino.h>
+#include <Stream.h>
+#include <DFRobot_RTU.h>
+
+#define RS01_TRANSPORT_MAX_REGS       24     ///< registers one transaction may carry, sizes the frame buffers of the backends
+#define RS01_TRANSPORT_TIMEOUT_MS     500    ///< default response timeout of a transaction
+
+/**
+ * @brief Base of the transports, a backend implements the frame I/O in service()
+ * @note Transactions are queued by submit() and completed from service(), which never blocks on a response:
+ * @n    backends that can have several requests outstanding(DFRobot_RS01TCPTransport) keep them in flight together.
+ */
+class DFRobot_RS01Transport
+{
+public:
+  /**
+   * @enum eTransactionState_t
+   * @brief State of a transaction
+   */
+  typedef enum
+  {
+    eTransactionIdle = 0,   /**< not submitted */
+    eTransactionPending,   /**< queued or in flight, owned by the transport */
+    eTransactionDone,   /**< completed, ret holds the result */
+  }eTransactionState_t;
+
+  /**
+   * @struct sTransaction_t
+   * @brief One read(0x03) or write(0x10) of holding registers, owned by the caller, must stay valid until it completes
+   */
+  typedef struct sTransaction
+  {
+    uint8_t addr;   /**< slave address, 0 broadcasts a write, no response is awaited */
+    uint8_t function;   /**< 0x03 read holding registers, 0x10 write holding registers */
+    uint16_t reg;   /**< first register */
+    uint8_t count;   /**< number of registers, 1~RS01_TRANSPORT_MAX_REGS */
+    uint16_t *pBuf;   /**< register values, filled by a read, sent by a write */
+    volatile uint8_t state;   /**< eTransactionState_t */
+    uint8_t ret;   /**< 0 means success, otherwise the RTU exception code */
+    void (*callback)(struct sTransaction *t);   /**< called from service() on completion, NULL for none */
+    void *context;   /**< free for the owner of the transaction */
+    struct sTransaction *next;   /**< queue link, used by the transport */
+    uint32_t timeoutMs;   /**< response timeout of this transaction in ms, 0 uses the one of the transport(setTimeout()) */
+  }sTransaction_t;
+
+  DFRobot_RS01Transport(void);
+
+  /**
+   * @fn submit
+   * @brief Queue a transaction, it is sent and completed from service()
+   * @param t the transaction
+   * @return true means queued, false if it is still pending or malformed
+   */
+  bool submit(sTransaction_t *t);
+
+  /**
+   * @fn service
+   * @brief Move the transactions forward: send the queued ones the backend has room for, collect responses, expire timeouts
+   * @return None
+   */
+  virtual void service(void) = 0;
+
+  /**
+   * @fn setTimeout
+   * @brief Set the response timeout of the transactions
+   * @param ms timeout in ms
+   * @return None
+   */
+  virtual void setTimeout(uint32_t ms);
+
+  /**
+   * @fn getTimeout
+   * @brief Get the response timeout of the transactions
+   * @return uint32_t, timeout in ms
+   */
+  uint32_t getTimeout(void);
+
+  /**
+   * @fn transfer
+   * @brief Blocking helper: submit a transaction and service the transport until it completes
+   * @param t the transaction
+   * @return uint8_t, 0 means success, otherwise the RTU exception code
+   */
+  uint8_t transfer(sTransaction_t *t);
+
+  /**
+   * @fn isIdle
+   * @brief Check whether the transport has nothing queued or in flight
+   * @return true means idle
+   */
+  virtual bool isIdle(void);
+
+protected:
+  /**
+   * @fn dequeue
+   * @brief Take the oldest queued transaction
+   * @return sTransaction_t *, NULL if the queue is empty
+   */
+  sTransaction_t *dequeue(void);
+
+  /**
+   * @fn complete
+   * @brief Finish a transaction and invoke its callback
+   * @param t the transaction
+   * @param ret the result
+   * @return None
+   */
+  void complete(sTransaction_t *t, uint8_t ret);
+
+  /**
+   * @fn timeoutOf
+   * @brief Get the response timeout that applies to a transaction
+   * @param t the transaction
+   * @return uint32_t, its own timeout if set, otherwise the one of the transport
+   */
+  uint32_t timeoutOf(const sTransaction_t *t);
+
+  /**
+   * @fn buildPDU
+   * @brief Encode the request PDU of a transaction: function code and data, big-endian
+   * @param t the transaction
+   * @param pdu buffer of at least 6 + 2 * RS01_TRANSPORT_MAX_REGS bytes
+   * @return uint8_t, the PDU length
+   */
+  static uint8_t buildPDU(const sTransaction_t *t, uint8_t *pdu);
+
+  /**
+   * @fn parsePDU
+   * @brief Check the response PDU of a transaction and byte-swap the registers of a read straight into pBuf
+   * @param t the transaction
+   * @param pdu the response PDU, starting at the function code
+   * @param len PDU length
+   * @return uint8_t, 0 means success, the exception code of an exception response, eRTU_RECV_ERROR for a malformed one
+   */
+  static uint8_t parsePDU(sTransaction_t *t, const uint8_t *pdu, uint8_t len);
+
+  uint32_t _timeoutMs;   // response timeout
+
+private:
+  sTransaction_t *_head;   // oldest queued transaction
+  sTransaction_t *_tail;   // newest queued transaction
+};
+
+/**
+ * @brief Backend over the DFRobot_RTU library, one blocking transaction per service() call
+ */
+class DFRobot_RS01RTUTransport : public DFRobot_RS01Transport
+{
+public:
+  /**
+   * @fn DFRobot_RS01RTUTransport
+   * @brief constructor
+   * @param rtu modbus-RTU object
+   * @param _serial serial port of that object, needed for broadcast writes only, NULL refuses them
+   * @note DFRobot_RTU waits for a response to every frame, so broadcasts are written straight to _serial, outside its
+   * @n    frame timing: the 3.5 character silence before them is not enforced, queue them after a completed transaction
+   * @return None
+   */
+  DFRobot_RS01RTUTransport(DFRobot_RTU *rtu, Stream *_serial = NULL);
+
+  void service(void);
+  void setTimeout(uint32_t ms);
+
+private:
+  DFRobot_RTU *_rtu;   // modbus-RTU object
+  Stream *_stream;   // its serial port
+};
+
+#endif
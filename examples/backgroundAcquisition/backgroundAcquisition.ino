@@ -0,0 +1,55 @@
+/*!
+ * @file  backgroundAcquisition.ino
+ * @brief  Read the sensor from a task pinned to the other core(ESP32 only)
+ * @details  Experimental phenomenon: the sensor is read every 20ms in the background,
+ * @n        loop() keeps its own timing and prints a consistent snapshot twice a second
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#if !defined(ESP32)
+  #error "This example needs the FreeRTOS tasks of the ESP32"
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+
+  while( NO_ERROR != sensor.begin(/*s =*/&Serial1) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  /**
+   * Read every 20ms from a task pinned to core 0, loop() runs on core 1
+   * From now on the task owns the sensor: read the data with readSnapshot() only
+   */
+  if(0 != sensor.startBackgroundAcquisition(/*periodMs =*/20, /*core =*/0)){
+    Serial.println("Failed to start the background task!!!");
+  }
+}
+
+void loop()
+{
+  DFRobot_RS01::sSample_t sample;
+  if(sensor.readSnapshot(&sample)){
+    Serial.print(sample.timestamp);
+    Serial.print(" us  targets: ");
+    Serial.print(sample.targetCount);
+    Serial.print("  nearest distance: ");
+    Serial.print(sample.distance[0]);
+    Serial.print("  intensity: ");
+    Serial.println(sample.intensity[0]);
+  }
+  delay(500);
+}
@@ -0,0 +1,178 @@
+/*!
+ * @file  benchmark.ino
+ * @brief  Measure the sample rate achievable for every baud rate, check bit and stop bit combination
+ * @details  Experimental phenomenon: for each link setting the sensor is reconfigured, power cycled and read for a few seconds,
+ * @n        one CSV line per setting is printed: samples per second, p50/p99 latency and error rate
+ * @n        The new settings only take effect after a restart: wire POWER_PIN to a switch on the sensor supply,
+ * @n        or leave it undefined and power cycle the sensor by hand when asked.
+ * @n        A hardware serial port is needed for the check bit and the high baud rates.
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #error "The benchmark needs a hardware serial port with parity support(Serial1)"
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+// #define POWER_PIN 7   // drives the sensor supply switch, HIGH means powered
+#define RUN_TIME_MS    3000   // measuring time of one setting
+#define LATENCY_SLOTS  128    // latencies kept per setting for the percentiles
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+const uint32_t baudrates[] = {2400, 4800, 9600, 14400, 19200, 38400, 57600, 115200, 1000000};
+const DFRobot_RS01::eBaudrateMode_t baudModes[] = {
+  DFRobot_RS01::eBaudrate2400, DFRobot_RS01::eBaudrate4800, DFRobot_RS01::eBaudrate9600,
+  DFRobot_RS01::eBaudrate14400, DFRobot_RS01::eBaudrate19200, DFRobot_RS01::eBaudrate38400,
+  DFRobot_RS01::eBaudrate57600, DFRobot_RS01::eBaudrate115200, DFRobot_RS01::eBaudrate_1000000,
+};
+const uint16_t checkBits[] = {DFRobot_RS01::eCheckBitNone, DFRobot_RS01::eCheckBitEven, DFRobot_RS01::eCheckBitOdd};
+const uint16_t stopBits[] = {DFRobot_RS01::eStopBit1, DFRobot_RS01::eStopBit2};
+const char parityName[] = {'N', 'E', 'O'};
+
+/* Arduino serial config of check bit c and stop bit s */
+uint32_t serialConfig(uint8_t c, uint8_t s)
+{
+  const uint32_t config[3][2] = {
+    {SERIAL_8N1, SERIAL_8N2},
+    {SERIAL_8E1, SERIAL_8E2},
+    {SERIAL_8O1, SERIAL_8O2},
+  };
+  return config[c][s];
+}
+
+/* Open the host side of the link */
+void openLink(uint32_t baudrate, uint32_t config)
+{
+  Serial1.end();
+#if defined(ESP32)
+  Serial1.begin(baudrate, config, /*rx =*/D3, /*tx =*/D2);
+#else
+  Serial1.begin(baudrate, config);
+#endif
+}
+
+/* Restart the sensor so the new link settings take effect */
+void powerCycle(void)
+{
+#if defined(POWER_PIN)
+  digitalWrite(POWER_PIN, LOW);
+  delay(500);
+  digitalWrite(POWER_PIN, HIGH);
+#else
+  Serial.println("# power cycle the sensor, then send any character");
+  while(Serial.available()) Serial.read();
+  while(!Serial.available());
+  while(Serial.available()) Serial.read();
+#endif
+}
+
+/* Sort the latencies for the percentiles, insertion sort is enough for a few hundred values */
+void sortLatency(uint32_t *pBuf, uint16_t n)
+{
+  for(uint16_t i = 1; i < n; i++){
+    uint32_t v = pBuf[i];
+    int16_t j = i - 1;
+    while((j >= 0) && (pBuf[j] > v)){
+      pBuf[j + 1] = pBuf[j];
+      j--;
+    }
+    pBuf[j + 1] = v;
+  }
+}
+
+/* Read the sensor for RUN_TIME_MS and print one CSV line */
+void runOne(uint32_t baudrate, uint8_t c, uint8_t s)
+{
+  static uint32_t latency[LATENCY_SLOTS];
+  uint16_t kept = 0;
+  uint32_t ok = 0, failed = 0;
+  DFRobot_RS01::sStats_t stats;
+
+  sensor.resetStats();
+  uint32_t start = millis();
+  while(millis() - start < RUN_TIME_MS){
+    uint32_t t = micros();
+    if(0 == sensor.refreshMeasurementData()){
+      ok++;
+    }else{
+      failed++;
+    }
+    t = micros() - t;
+    if(kept < LATENCY_SLOTS){
+      latency[kept++] = t;
+    }else{
+      long j = random(ok + failed);   // Reservoir sampling: every read of the run is kept with the same probability
+      if(j < LATENCY_SLOTS){
+        latency[j] = t;
+      }
+    }
+  }
+  uint32_t elapsed = millis() - start;
+  sensor.getStats(&stats);
+  sortLatency(latency, kept);
+
+  Serial.print(baudrate);               Serial.print(',');
+  Serial.print(parityName[c]);          Serial.print(',');
+  Serial.print(s + 1);                  Serial.print(',');
+  Serial.print(ok * 1000.0 / elapsed);  Serial.print(',');
+  Serial.print(kept ? latency[kept / 2] : 0);          Serial.print(',');
+  Serial.print(kept ? latency[(kept * 99) / 100] : 0); Serial.print(',');
+  Serial.print((ok + failed) ? (100.0 * failed / (ok + failed)) : 0.0); Serial.print(',');
+  Serial.print(stats.read.crcErrors);   Serial.print(',');
+  Serial.println(stats.read.timeouts);
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  while(!Serial);
+#if defined(POWER_PIN)
+  pinMode(POWER_PIN, OUTPUT);
+  digitalWrite(POWER_PIN, HIGH);
+#endif
+
+  /* Start at the factory link setting 115200 8N1 */
+  openLink(115200, SERIAL_8N1);
+  while( NO_ERROR != sensor.begin(/*s =*/&Serial1) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+
+  Serial.println("baudrate,parity,stopbits,samples_per_s,p50_us,p99_us,error_pct,crc_errors,timeouts");
+  for(uint8_t b = 0; b < sizeof(baudrates) / sizeof(baudrates[0]); b++){
+    for(uint8_t c = 0; c < 3; c++){
+      for(uint8_t s = 0; s < 2; s++){
+        /* Configure the next setting while the link still runs at the current one */
+        if((0 != sensor.setBaudrateMode(baudModes[b])) || (0 != sensor.setCheckbitStopbit(checkBits[c] | stopBits[s]))){
+          Serial.println("# failed to configure the sensor, stop");
+          return;
+        }
+        powerCycle();
+        openLink(baudrates[b], serialConfig(c, s));
+        if(0 != sensor.waitReady(RS01_READY_TIMEOUT_MS)){
+          Serial.print("# no answer at ");
+          Serial.print(baudrates[b]);
+          Serial.println(", the sensor keeps this setting: restore it with setModuleInfo.ino");
+          return;
+        }
+        runOne(baudrates[b], c, s);
+      }
+    }
+  }
+
+  /* Back to the factory link setting */
+  sensor.setBaudrateMode(DFRobot_RS01::eBaudrate115200);
+  sensor.setCheckbitStopbit(DFRobot_RS01::eCheckBitNone | DFRobot_RS01::eStopBit1);
+  powerCycle();
+  Serial.println("# done, the sensor is back to 115200 8N1");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,73 @@
+/*!
+ * @file  changeDetection.ino
+ * @brief  Only forward the measured data when the scene changes
+ * @details  Experimental phenomenon: a frame is printed only when the target count changes or a target moves
+ * @n        past the deadband, the poll interval stretches up to 2s while nothing changes and drops back to 50ms on a change
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  /* Distance changes up to 10 and intensity changes up to 200 are noise */
+  sensor.setChangeDeadband(/*distance =*/10, /*intensity =*/200);
+  /* 50ms while the scene changes, up to 2000ms while it is static */
+  sensor.setPollInterval(/*minMs =*/50, /*maxMs =*/2000);
+}
+
+void loop()
+{
+  int ret;
+  switch(sensor.pollForChange(&ret)){
+    case DFRobot_RS01::eChangeUpdated:
+      Serial.print("targets: ");
+      Serial.print(sensor.measurement.targetCount);
+      Serial.print("  nearest: ");
+      Serial.print(sensor.measurement.distance[0]);
+      Serial.print("  next poll in: ");
+      Serial.print(sensor.getPollInterval());
+      Serial.println(" ms");
+      break;
+    case DFRobot_RS01::eChangeError:
+      Serial.print("read failed: ");
+      Serial.println(ret);
+      break;
+    default:   // Not due yet, or unchanged: nothing to forward
+      break;
+  }
+}
@@ -0,0 +1,119 @@
+/*!
+ * @file  dutyCycle.ino
+ * @brief  Battery deployment: wake every 5 seconds, read the sensor once, publish and switch everything off again
+ * @details  Experimental phenomenon: the nearest distance is printed once per cycle; every 10 cycles the awake time
+ * @n        per sample and the duty cycle are printed, the figures to size the battery and the solar panel with
+ * @n        The sensor supply is switched by a MOSFET/load switch on SENSOR_POWER_PIN, the DE/RE pins of the RS485
+ * @n        transceiver are driven by TRANSCEIVER_EN_PIN(low: receiver on; high: both off with the usual wiring of
+ * @n        DE to the pin and RE through an inverter, adapt transceiverSwitch() to the board)
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <DFRobot_RS01DutyCycle.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+#define SENSOR_POWER_PIN       6
+#define TRANSCEIVER_EN_PIN     7
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+DFRobot_RS01DutyCycle duty(/*sensor =*/&sensor);
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+void sensorPower(bool on)
+{
+  digitalWrite(SENSOR_POWER_PIN, on ? HIGH : LOW);
+}
+
+void transceiverSwitch(bool on)
+{
+  digitalWrite(TRANSCEIVER_EN_PIN, on ? LOW : HIGH);
+}
+
+void publish(DFRobot_RS01 *s, uint8_t ret)
+{
+  if(0 == ret){
+    Serial.print("nearest object distance: ");
+    Serial.print(s->measurement.distance[0]);
+    Serial.println(" mm");
+  }else{
+    Serial.print("read failed: ");
+    Serial.println(ret);
+  }
+#if defined(ESP32)||defined(ESP8266)
+  Serial.flush();   // Let the UART drain before a light sleep stops it
+#endif
+}
+
+#if defined(ESP32)
+void lightSleep(uint32_t ms)
+{
+  esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+  esp_light_sleep_start();
+}
+#endif
+
+void setup(void)
+{
+  Serial.begin(115200);
+  pinMode(SENSOR_POWER_PIN, OUTPUT);
+  pinMode(TRANSCEIVER_EN_PIN, OUTPUT);
+  sensorPower(true);
+  transceiverSwitch(true);
+
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  sensor.setAdaptiveTimeout(true);   // A lost response then costs a few ms of awake time instead of the full 500ms
+
+  while( 0 != duty.begin() ){   // Snapshot of the configuration, the power-ups skip reading it again
+    Serial.println("Reading the configuration failed");
+    delay(3000);
+  }
+  duty.setSensorPowerHook(sensorPower);
+  duty.setTransceiverHook(transceiverSwitch);
+  duty.setPublishCallback(publish);
+#if defined(ESP32)
+  duty.setSleepHook(lightSleep);
+#endif
+  duty.setPeriod(/*ms =*/5000);
+}
+
+void loop()
+{
+  duty.cycle();   // Returns when the next cycle is due
+
+  DFRobot_RS01DutyCycle::sDutyStats_t stats;
+  duty.getStats(&stats);
+  if(0 == (stats.cycles % 10)){
+    Serial.print("awake per sample: "); Serial.print(stats.awakeUsPerSample);
+    Serial.print(" us  sensor ready after: "); Serial.print(stats.lastReadyUs);
+    Serial.print(" us  duty: "); Serial.print(stats.dutyPermille / 10.0, 1);
+    Serial.print(" %  errors: "); Serial.println(stats.errors);
+  }
+}
@@ -0,0 +1,91 @@
+/*!
+ * @file  fastStart.ino
+ * @brief  Keep the sensor configuration in EEPROM so that a reboot doesn't read it again
+ * @details  Experimental phenomenon: the first boot reads the whole register map and stores a snapshot,
+ * @n        the following boots print "snapshot restored" and skip the configuration reads; a snapshot
+ * @n        that no longer matches the sensor(another sensor, firmware update, new baud rate) is replaced
+ * @n        On ESP32 a snapshot kept in a RTC_DATA_ATTR variable survives deep sleep without flash writes
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <EEPROM.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+#define SNAPSHOT_EEPROM_ADDR   0
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+DFRobot_RS01::sSnapshot_t snapshot;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+#if defined(ESP32)||defined(ESP8266)
+  EEPROM.begin(sizeof(snapshot));   // The EEPROM is emulated in flash
+#endif
+  EEPROM.get(SNAPSHOT_EEPROM_ADDR, snapshot);
+  sensor.setSnapshot(&snapshot);   // A blank or corrupt EEPROM fails the CRC check and is ignored
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  if(sensor.isSnapshotRestored()){
+    Serial.println("snapshot restored");
+  }else{
+    Serial.println("snapshot missing or stale, reading the sensor");
+    DFRobot_RS01::sSnapshot_t fresh;
+    if((0 == sensor.refreshAll()) && sensor.getSnapshot(&fresh) &&
+       (0 != memcmp(&fresh, &snapshot, sizeof(fresh)))){   // Write only when it changed, flash wears out
+      snapshot = fresh;
+      EEPROM.put(SNAPSHOT_EEPROM_ADDR, snapshot);
+#if defined(ESP32)||defined(ESP8266)
+      EEPROM.commit();
+#endif
+      Serial.println("snapshot stored");
+    }
+  }
+
+  Serial.print("measurement start position: ");
+  Serial.println(sensor.measurementConfig.startPosition);
+  Serial.print("measurement stop position: ");
+  Serial.println(sensor.measurementConfig.stopPosition);
+  Serial.print("firmware version: 0x");
+  Serial.println(sensor.basicInfo.versions, HEX);
+}
+
+void loop()
+{
+  if(0 == sensor.refreshMeasurementData()){
+    Serial.print("nearest object distance: ");
+    Serial.print(sensor.measurement.distance[0]);
+    Serial.println(" mm");
+  }
+  delay(1000);
+}
@@ -0,0 +1,77 @@
+/*!
+ * @file  filteredMeasurement.ino
+ * @brief  Filter the measured data on the device before it is handed out
+ * @details  Experimental phenomenon: targets outside the configured measurement window are dropped,
+ * @n        the remaining distances and intensities pass a 5-tap median and a moving average,
+ * @n        both the raw(dataBuf) and the filtered(measurement) nearest distance are printed
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <DFRobot_RS01Filter.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+/**
+ * Median over the last 5 samples(odd, 1~15) of every target
+ */
+DFRobot_RS01Filter<5> filter;
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  /* The range gate follows measurementConfig.startPosition/stopPosition once they are read */
+  sensor.refreshMeasurementConfig();
+  filter.setRange(/*minDistance =*/0, /*maxDistance =*/0);
+  /* Moving average with a smoothing factor of 1/2^2 behind the median, 0 disables it */
+  filter.setEMA(/*shift =*/2);
+  sensor.setStage(&filter);
+}
+
+void loop()
+{
+  if(0 == sensor.refreshMeasurementData()){
+    Serial.print("raw nearest: ");
+    Serial.print(sensor.dataBuf[1]);
+    Serial.print("  filtered targets: ");
+    Serial.print(sensor.measurement.targetCount);
+    Serial.print("  filtered nearest: ");
+    Serial.print(sensor.measurement.distance[0]);
+    Serial.print("  rejected: ");
+    Serial.println(filter.getRejected());
+  }else{
+    Serial.println("Failed to read measurement data!!!");
+  }
+  delay(100);
+}
@@ -0,0 +1,85 @@
+/*!
+ * @file  fixedRateSampling.ino
+ * @brief  Sample the sensor at a steady 50Hz on absolute deadlines and report the timing quality
+ * @details  Experimental phenomenon: the nearest distance is printed 50 times a second although loop() does
+ * @n        a variable amount of other work, the interval jitter statistics are printed every 5 seconds
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+uint32_t lastReportMs = 0;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  /**
+   * 50 samples a second, deadlines missed while loop() was busy are skipped(eSampleDrop);
+   * eSampleCatchUp reads for them back to back instead, so the sample count stays on rate
+   */
+  sensor.setSampleRate(/*hz =*/50, /*policy =*/DFRobot_RS01::eSampleDrop);
+}
+
+void loop()
+{
+  int ret;
+  switch(sensor.service(&ret)){
+    case DFRobot_RS01::eSampleReady:
+      Serial.println(sensor.measurement.distance[0]);
+      break;
+    case DFRobot_RS01::eSampleError:
+      Serial.print("read failed: ");
+      Serial.println(ret);
+      break;
+    default:   // Not due yet, or the response is still on its way
+      break;
+  }
+
+  if((millis() - lastReportMs) >= 5000){
+    lastReportMs = millis();
+    DFRobot_RS01::sSampleStats_t stats;
+    sensor.getSampleStats(&stats);
+    Serial.print("samples: "); Serial.print(stats.samples);
+    Serial.print("  dropped: "); Serial.print(stats.dropped);
+    Serial.print("  interval min/avg/max: "); Serial.print(stats.minIntervalUs);
+    Serial.print("/"); Serial.print(stats.avgIntervalUs);
+    Serial.print("/"); Serial.print(stats.maxIntervalUs);
+    Serial.print(" us  jitter(stddev): "); Serial.print(stats.stddevUs);
+    Serial.println(" us");
+  }
+
+  delay(random(10));   // Stands for the variable work of the application
+}
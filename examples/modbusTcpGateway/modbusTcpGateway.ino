@@ -0,0 +1,82 @@
+/*!
+ * @file  modbusTcpGateway.ino
+ * @brief  Read several RS01 behind an RS485-to-Ethernet gateway over modbus-TCP(ESP32 WiFi)
+ * @details  Experimental phenomenon: the measurement reads of all sensors are submitted together,
+ * @n        the transport keeps them in flight at once and each sensor prints its nearest target on completion
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <DFRobot_RS01TCPTransport.h>
+#if !defined(ESP32)
+  #error "This example uses the WiFi of the ESP32, any other Client(e.g. EthernetClient) works the same way"
+#endif
+#include <WiFi.h>
+
+#define WIFI_SSID      "your_ssid"
+#define WIFI_PASSWORD  "your_password"
+#define GATEWAY_HOST   "192.168.1.100"   // address of the RS485-to-Ethernet gateway
+#define GATEWAY_PORT   502   // its modbus-TCP port
+
+WiFiClient client;
+/* Up to 4 requests outstanding at once */
+DFRobot_RS01TCPTransport transport(&client, /*maxInFlight =*/4);
+
+DFRobot_RS01 sensors[] = {DFRobot_RS01(/*addr =*/0x0E), DFRobot_RS01(/*addr =*/0x0F), DFRobot_RS01(/*addr =*/0x10)};
+#define SENSOR_COUNT (sizeof(sensors) / sizeof(sensors[0]))
+
+/* Called from poll() when the read of a sensor completes */
+void onMeasurement(DFRobot_RS01 *s, uint8_t ret)
+{
+  Serial.print("sensor 0x");
+  Serial.print(s->basicInfo.modbusAddr, HEX);
+  if(0 == ret){
+    Serial.print("  nearest: ");
+    Serial.println(s->measurement.distance[0]);
+  }else{
+    Serial.print("  read failed: ");
+    Serial.println(ret);
+  }
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+  while(WL_CONNECTED != WiFi.status()){
+    delay(500);
+  }
+  while(!client.connect(GATEWAY_HOST, GATEWAY_PORT)){
+    Serial.println("Connection to the gateway failed, please check the address");
+    delay(3000);
+  }
+
+  for(uint8_t i = 0; i < SENSOR_COUNT; i++){
+    while( NO_ERROR != sensors[i].begin(/*transport =*/&transport) ){
+      Serial.println("Communication with device failed, please check connection");
+      delay(3000);
+    }
+    sensors[i].setMeasurementCallback(onMeasurement);
+  }
+  Serial.println("Begin ok!");
+}
+
+void loop()
+{
+  if(!client.connected()){
+    client.connect(GATEWAY_HOST, GATEWAY_PORT);   // The transport fails what was in flight, reconnecting is up to us
+  }
+
+  /* Submit the reads of all sensors, then let the transport pipeline them */
+  for(uint8_t i = 0; i < SENSOR_COUNT; i++){
+    sensors[i].startMeasurementRead();
+  }
+  while(!transport.isIdle()){
+    transport.service();   // Sends, collects and completes, the sensors' callbacks run from here
+  }
+  delay(100);
+}
@@ -0,0 +1,92 @@
+/*!
+ * @file  multiGatewaySweep.ino
+ * @brief  Sweep sensors behind two modbus-TCP gateways with every request in flight at once(ESP32 WiFi)
+ * @details  Experimental phenomenon: every 200ms all sensors are read in one pipelined sweep,
+ * @n        each completed frame is printed as it arrives and the sweep time is printed at the end,
+ * @n        it stays close to the slowest gateway round trip instead of growing with the number of sensors
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <DFRobot_RS01Sweep.h>
+#include <DFRobot_RS01TCPTransport.h>
+#if !defined(ESP32)
+  #error "This example uses the WiFi of the ESP32, any other Client(e.g. EthernetClient) works the same way"
+#endif
+#include <WiFi.h>
+
+#define WIFI_SSID      "your_ssid"
+#define WIFI_PASSWORD  "your_password"
+#define GATEWAY_PORT   502   // modbus-TCP port of the gateways
+const char *gatewayHosts[] = {"192.168.1.100", "192.168.1.101"};
+
+WiFiClient clients[2];
+DFRobot_RS01TCPTransport transports[] = {DFRobot_RS01TCPTransport(&clients[0]), DFRobot_RS01TCPTransport(&clients[1])};
+
+/* Three sensors on each RS485 segment */
+DFRobot_RS01 sensors[] = {DFRobot_RS01(0x0E), DFRobot_RS01(0x0F), DFRobot_RS01(0x10),
+                          DFRobot_RS01(0x0E), DFRobot_RS01(0x0F), DFRobot_RS01(0x10)};
+#define SENSOR_COUNT (sizeof(sensors) / sizeof(sensors[0]))
+
+DFRobot_RS01Sweep sweep;
+
+/* Called from sweep.poll() for every completed read, in the order the responses arrive */
+void onSample(uint8_t index, DFRobot_RS01 *sensor, uint8_t ret)
+{
+  Serial.print("sensor ");
+  Serial.print(index);
+  if(0 == ret){
+    Serial.print("  nearest: ");
+    Serial.println(sensor->measurement.distance[0]);
+  }else{
+    Serial.print("  read failed: ");
+    Serial.println(ret);
+  }
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+  while(WL_CONNECTED != WiFi.status()){
+    delay(500);
+  }
+  for(uint8_t g = 0; g < 2; g++){
+    while(!clients[g].connect(gatewayHosts[g], GATEWAY_PORT)){
+      Serial.println("Connection to a gateway failed, please check the address");
+      delay(3000);
+    }
+  }
+
+  for(uint8_t i = 0; i < SENSOR_COUNT; i++){
+    while( NO_ERROR != sensors[i].begin(/*transport =*/&transports[i / 3]) ){
+      Serial.println("Communication with device failed, please check connection");
+      delay(3000);
+    }
+    sweep.addSensor(&sensors[i]);
+  }
+  Serial.println("Begin ok!");
+
+  sweep.setSweepCallback(onSample);
+  sweep.setPeriod(/*ms =*/200);
+}
+
+void loop()
+{
+  for(uint8_t g = 0; g < 2; g++){
+    if(!clients[g].connected()){
+      clients[g].connect(gatewayHosts[g], GATEWAY_PORT);   // The transport fails what was in flight, reconnecting is up to us
+    }
+  }
+
+  /* Never blocks: services both gateways and starts the next sweep when it is due */
+  if(sweep.poll()){
+    Serial.print("sweep time: ");
+    Serial.print(sweep.getSweepUs());
+    Serial.println(" us");
+  }
+}
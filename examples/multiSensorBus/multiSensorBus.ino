@@ -0,0 +1,84 @@
+/*!
+ * @file  multiSensorBus.ino
+ * @brief  Poll several sensors sharing one RS485 segment
+ * @details  Experimental phenomenon: serial print the nearest target of every sensor as soon as it is read
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01Bus.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define BUS_BAUDRATE 115200
+
+/**
+ * Every sensor on the segment needs its own modbus address(range 1~247), set it beforehand with setModuleInfo.ino
+ */
+DFRobot_RS01 sensor1(/*addr =*/0x000E);
+DFRobot_RS01 sensor2(/*addr =*/0x000F);
+DFRobot_RS01 sensor3(/*addr =*/0x0010);
+DFRobot_RS01 *sensors[] = {&sensor1, &sensor2, &sensor3};
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+  DFRobot_RS01Bus bus(/*s =*/&mySerial, /*baudrate =*/BUS_BAUDRATE);
+#else
+  DFRobot_RS01Bus bus(/*s =*/&Serial1, /*baudrate =*/BUS_BAUDRATE);
+#endif
+
+/* Called by bus.poll() after every measurement read */
+void onSample(uint8_t index, DFRobot_RS01 *sensor, uint8_t ret)
+{
+  Serial.print("sensor ");
+  Serial.print(index);
+  if(ret){
+    Serial.print(" read failed: ");
+    Serial.println(ret);
+    return;
+  }
+  Serial.print(" targets: ");
+  Serial.print(sensor->measurement.targetCount);
+  Serial.print(" nearest distance: ");
+  Serial.println(sensor->measurement.distance[0]);
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(BUS_BAUDRATE);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+#elif defined(ESP32)
+  Serial1.begin(BUS_BAUDRATE, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+#else
+  Serial1.begin(BUS_BAUDRATE);
+#endif
+
+  /**
+   * Register the sensors, the weight sets the share of the poll schedule:
+   * here sensor1 is read twice as often as the others
+   */
+  for(uint8_t i = 0; i < sizeof(sensors) / sizeof(sensors[0]); i++){
+    int ret = bus.addSensor(sensors[i], /*weight =*/(0 == i) ? 2 : 1);
+    if(0 > ret){
+      Serial.print("Failed to add sensor ");
+      Serial.print(i);
+      Serial.print(", error: ");
+      Serial.println(ret);
+    }
+  }
+  bus.setSampleCallback(onSample);
+  Serial.println("Begin ok!");
+}
+
+void loop()
+{
+  /**
+   * Read the next sensor in the schedule, the modbus inter-frame silence is kept automatically
+   */
+  bus.poll();
+}
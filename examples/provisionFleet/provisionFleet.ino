@@ -0,0 +1,82 @@
+/*!
+ * @file  provisionFleet.ino
+ * @brief  Find every RS01 on the bus and bring all of them to the same measurement parameters
+ * @details  Experimental phenomenon: the serial port prints one line per sensor found with the result of the
+ * @n        write and read-back, then a summary with the time the scan and the configuration took.
+ * @n        Every sensor needs a unique address beforehand, see setModuleInfo.ino
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01Provisioner.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+DFRobot_RTU *rtu;
+DFRobot_RS01RTUTransport *transport;
+DFRobot_RS01Provisioner *provisioner;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+  delay(1100);   // Power-up time of the sensors
+
+  /* The serial port is passed to the transport too, it sends the broadcast writes itself */
+  rtu = new DFRobot_RTU(_serial);
+  transport = new DFRobot_RS01RTUTransport(rtu, _serial);
+  provisioner = new DFRobot_RS01Provisioner(transport);
+
+  /* An absent address costs 20ms: scanning 1~247 takes about 5s on one RS485 line */
+  provisioner->setScanTimeout(/*ms =*/20);
+  Serial.print("sensors found: ");
+  Serial.println(provisioner->scan(/*first =*/1, /*last =*/247));
+
+  /**
+   * Target configuration, only the fields selected are written:
+   *   RS01_PROVISION_MEASUREMENT: start position, stop position, initial threshold, end threshold, sensitivity, comparison offset
+   *   RS01_PROVISION_BAUDRATE / RS01_PROVISION_CHECKBIT_STOPBIT: take effect after a power cycle
+   */
+  DFRobot_RS01Provisioner::sProvisionTarget_t target;
+  target.fields = RS01_PROVISION_MEASUREMENT;
+  target.baudrate = DFRobot_RS01::eBaudrate115200;
+  target.checkbitStopbit = DFRobot_RS01::eCheckBitNone | DFRobot_RS01::eStopBit1;
+  target.measurement.startPosition = 0x00C8;
+  target.measurement.stopPosition = 0x1770;
+  target.measurement.initialThreshold = 0x0190;
+  target.measurement.endThreshold = 0x0190;
+  target.measurement.moduleSensitivity = 0x0002;
+  target.measurement.comparisonOffset = 0x0000;
+  if(!provisioner->setTarget(&target)){
+    Serial.println("target out of range");
+    return;
+  }
+
+  /* One broadcast write reaches all sensors, then each one is read back; refused when other devices share the bus */
+  provisioner->setBroadcast(true);
+  provisioner->apply();
+  provisioner->printReport(&Serial);
+}
+
+void loop()
+{
+  delay(1000);
+}
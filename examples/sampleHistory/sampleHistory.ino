@@ -0,0 +1,90 @@
+/*!
+ * @file  sampleHistory.ino
+ * @brief  Keep a timestamped history of the measured data and drain it in batches
+ * @details  Experimental phenomenon: the sensor is read at full rate in the background of loop(),
+ * @n        every second the samples collected meanwhile are printed with their timestamps
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <DFRobot_RS01SampleRing.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+
+/**
+ * The history holds up to 32 samples(a power of two up to 128), older samples are kept and new ones dropped when it is full
+ */
+DFRobot_RS01SampleRing<32> history;
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+/* Called by sensor.poll() when a read completes: store the sample and start the next read */
+void onMeasurement(DFRobot_RS01 *s, uint8_t ret)
+{
+  if(0 == ret){
+    history.push(*s);
+  }
+  s->startMeasurementRead();
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  sensor.setMeasurementCallback(onMeasurement);
+  sensor.startMeasurementRead();
+}
+
+void loop()
+{
+  static uint32_t lastPrint = 0;
+
+  /* Keep the reads going, poll() never blocks */
+  sensor.poll();
+
+  if(millis() - lastPrint >= 1000){
+    lastPrint = millis();
+
+    DFRobot_RS01::sSample_t batch[8];
+    uint8_t n;
+    while(0 != (n = history.popBatch(batch, 8))){
+      for(uint8_t i = 0; i < n; i++){
+        Serial.print(batch[i].timestamp);
+        Serial.print(" us  targets: ");
+        Serial.print(batch[i].targetCount);
+        Serial.print("  nearest: ");
+        Serial.println(batch[i].distance[0]);
+      }
+    }
+    Serial.print("dropped: ");
+    Serial.println(history.getDropped());
+  }
+}
@@ -30,7 +30,7 @@ DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
 void print_measure_data(int number, uint16_t distance, uint16_t intensity)
 {
   Serial.print("target ");
-  Serial.print((number + 1) / 2);
+  Serial.print(number);
   Serial.print(" distance: ");
   Serial.print(distance);
   Serial.print("  ");
@@ -39,7 +39,7 @@ void print_measure_data(int number, uint16_t distance, uint16_t intensity)
   Serial.println();
 
   Serial.print("target ");
-  Serial.print((number + 1) / 2);
+  Serial.print(number);
   Serial.print(" intensity: ");
   Serial.print(intensity);
   Serial.print("  ");
@@ -150,24 +150,22 @@ void setup(void)
 void loop()
 {
   /**
-   * Re-read the measured data from the sensor and buffer it into the array dataBuf[11] that stores information:
-   *    dataBuf[0]: the number of objects currently detected
-   *    dataBuf[1]: measured distance to the first object; dataBuf[2]: measured intensity of the first object
-   *    dataBuf[3]: measured distance to the second object; dataBuf[4]: measured intensity of the second object
-   *    dataBuf[5]: measured distance to the third object; dataBuf[6]: measured intensity of the third object
-   *    dataBuf[7]: measured distance to the fourth object; dataBuf[8]: measured intensity of the fourth object
-   *    dataBuf[9]: measured distance to the fifth object; dataBuf[10]: measured intensity of the fifth object
+   * Re-read the measured data from the sensor and buffer it into measurement:
+   *    measurement.targetCount: the number of objects currently detected
+   *    measurement.distance[0~4]: measured distance to the first~fifth object
+   *    measurement.intensity[0~4]: measured intensity of the first~fifth object
+   *    (dataBuf[11] still holds the same data interleaved as in the registers)
    * returning 0 means read succeeds
    */
   if(0 == sensor.refreshMeasurementData()){
     /*The number of objects currently detected*/
     Serial.print("target amount:  ");
-    Serial.println(sensor.dataBuf[0]);
+    Serial.println(sensor.measurement.targetCount);
     Serial.println();
 
     /*measured data*/
-    for(int i=1; i<11; i+=2){
-      print_measure_data(i, sensor.dataBuf[i], sensor.dataBuf[i+1]);
+    for(int i=0; i<5; i++){
+      print_measure_data(i + 1, sensor.measurement.distance[i], sensor.measurement.intensity[i]);
     }
 
   }else{
@@ -0,0 +1,82 @@
+/*!
+ * @file  trackTargets.ino
+ * @brief  Follow the targets across frames with persistent IDs
+ * @details  Experimental phenomenon: every target gets an ID when it appears, its distance and velocity are printed
+ * @n        with that ID while it stays in view, and its departure is reported once it is gone
+ * @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+ * @license  The MIT License (MIT)
+ * @author   [qsjhyy](yihuan.huang@dfrobot.com)
+ * @version  V1.0
+ * @date  2021-07-06
+ * @url   https://github.com/DFRobot/DFRobot_RS01
+ */
+#include <DFRobot_RS01.h>
+#include <DFRobot_RS01Tracker.h>
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+#define DEFAULT_DEVICE_ADDRESS 0x000E
+
+DFRobot_RS01 sensor(/*addr =*/DEFAULT_DEVICE_ADDRESS);
+DFRobot_RS01Tracker tracker;
+
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  SoftwareSerial mySerial(/*rx =*/4, /*tx =*/5);
+#endif
+
+/* Called from refreshMeasurementData() when a target enters or leaves */
+void onTrack(const DFRobot_RS01Tracker::sTrack_t *track, DFRobot_RS01Tracker::eTrackEvent_t event)
+{
+  Serial.print((DFRobot_RS01Tracker::eTrackEnter == event) ? "enter  id: " : "leave  id: ");
+  Serial.print(track->id);
+  Serial.print("  distance: ");
+  Serial.println(track->distance);
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Stream *_serial;
+#if defined(ARDUINO_AVR_UNO)||defined(ESP8266)
+  mySerial.begin(115200);   // Excessive baud rate of UNO soft serial port will makes communication unstable, 9600 is recommended
+  _serial = &mySerial;
+#elif defined(ESP32)
+  Serial1.begin(115200, SERIAL_8N1, /*rx =*/D3, /*tx =*/D2);
+  _serial = &Serial1;
+#else
+  Serial1.begin(115200);
+  _serial = &Serial1;
+#endif
+
+  while( NO_ERROR != sensor.begin(/*s =*/_serial) ){
+    Serial.println("Communication with device failed, please check connection");
+    delay(3000);
+  }
+  Serial.println("Begin ok!");
+
+  /* Targets moving less than 100 between two frames are taken for the same one */
+  tracker.setGate(/*gate =*/100);
+  /* A target may be missing from 3 frames before it leaves */
+  tracker.setHold(/*frames =*/3);
+  tracker.setTrackCallback(onTrack);
+  /* A DFRobot_RS01Filter can be chained in front: sensor.setStage(&filter); filter.setNext(&tracker); */
+  sensor.setStage(&tracker);
+}
+
+void loop()
+{
+  if(0 == sensor.refreshMeasurementData()){
+    for(uint8_t i = 0; i < tracker.getTrackCount(); i++){
+      const DFRobot_RS01Tracker::sTrack_t *track = tracker.getTrack(i);
+      Serial.print("id: ");
+      Serial.print(track->id);
+      Serial.print("  distance: ");
+      Serial.print(track->distance);
+      Serial.print("  velocity: ");
+      Serial.print(track->velocity);
+      Serial.println("/s");
+    }
+  }
+  delay(100);
+}
@@ -123,7 +123,8 @@ class DFRobot_RS01(object):
     ## stop bit 2bit
     E_STOPBIT_2 = 0x0003
 
-    def __init__(self, addr, port="/dev/ttyAMA0", baud = 115200, bytesize = 8, parity = 'N', stopbit = 1, xonxoff=0):
+    def __init__(self, addr, port="/dev/ttyAMA0", baud = 115200, bytesize = 8, parity = 'N', stopbit = 1, xonxoff=0,
+                 master = None, lock = None):
         '''!
           @brief Module RTU communication init
           @param addr modbus communication address
@@ -133,14 +134,20 @@ class DFRobot_RS01(object):
           @param parity modbus communication check bit
           @param stopbit modbus communication stop bit
           @param xonxoff modbus communication synchronous and asynchronous setting
+          @param master modbus_rtu.RtuMaster shared with other sensors on the same port, None opens the port
+          @param lock lock serialising the access to a shared port(see RS01Bus), None when the port isn't shared
         '''
         self._rs01_addr = addr
+        self._lock = lock
 
-        self._DFRobot_RTU = modbus_rtu.RtuMaster(
-            serial.Serial(port, baud, bytesize, parity, stopbit, xonxoff)
-        )
-        self._DFRobot_RTU.set_timeout(0.5)
-        self._DFRobot_RTU.set_verbose(True)
+        if master is None:
+            self._DFRobot_RTU = modbus_rtu.RtuMaster(
+                serial.Serial(port, baud, bytesize, parity, stopbit, xonxoff)
+            )
+            self._DFRobot_RTU.set_timeout(0.5)
+            self._DFRobot_RTU.set_verbose(True)
+        else:
+            self._DFRobot_RTU = master
         self.reg_value_buf = [0, 0, 0, 0, 0, 0]
         self.reg_value_buf[0] = 0x00C8   # the default measurement start position 200
         self.reg_value_buf[1] = 0x1770   # the default measurement stop position 6000
@@ -296,7 +303,11 @@ class DFRobot_RS01(object):
         # Low level register writing, not implemented in base class
         if isinstance(data, int):
             data = [data]
-        ret = self._DFRobot_RTU.execute(self._rs01_addr, cst.WRITE_MULTIPLE_REGISTERS, reg, output_value=data)
+        if self._lock is None:
+            ret = self._DFRobot_RTU.execute(self._rs01_addr, cst.WRITE_MULTIPLE_REGISTERS, reg, output_value=data)
+        else:
+            with self._lock:
+                ret = self._DFRobot_RTU.execute(self._rs01_addr, cst.WRITE_MULTIPLE_REGISTERS, reg, output_value=data)
         logger.info(ret)
         return ret
 
@@ -308,4 +319,7 @@ class DFRobot_RS01(object):
           @return list: The value list of the holding register.
         '''
         # Low level register writing, not implemented in base class
-        return list(self._DFRobot_RTU.execute(self._rs01_addr, cst.READ_HOLDING_REGISTERS, reg, length))
+        if self._lock is None:
+            return list(self._DFRobot_RTU.execute(self._rs01_addr, cst.READ_HOLDING_REGISTERS, reg, length))
+        with self._lock:
+            return list(self._DFRobot_RTU.execute(self._rs01_addr, cst.READ_HOLDING_REGISTERS, reg, length))
@@ -0,0 +1,263 @@
+# -*- coding: utf-8 -*
+'''!
+  @file  DFRobot_RS01Async.py
+  @brief  Define the infrastructure of DFRobot_RS01Async class
+  @details  asyncio variant of DFRobot_RS01: the serial port is non-blocking and waited on through the
+  @n        event loop, so reads of several sensors can be gathered without an executor thread per call.
+  @n        Requires python3.5 or later and a POSIX serial port(Raspberry Pi)
+  @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+  @license  The MIT License (MIT)
+  @author  [qsjhyy](yihuan.huang@dfrobot.com)
+  @version  V1.0
+  @date  2021-07-23
+  @url  https://github.com/DFRobot/DFRobot_RS01
+'''
+import asyncio
+import serial
+
+from DFRobot_RS01 import *
+from DFRobot_RS01Bus import crc16
+
+class RS01AsyncBus(object):
+    '''!
+      @brief Non-blocking RS485 port shared by the DFRobot_RS01Async sensors on it
+      @details One request is on the bus at a time, frames are separated by the 3.5 character RTU silence
+    '''
+
+    def __init__(self, port="/dev/ttyAMA0", baud = 115200, bytesize = 8, parity = 'N', stopbit = 1, xonxoff=0, timeout = 0.5):
+        '''!
+          @brief Open the serial port in non-blocking mode
+          @param port modbus communication serial port
+          @param baud modbus communication baud rate
+          @param bytesize modbus communication byte size
+          @param parity modbus communication check bit
+          @param stopbit modbus communication stop bit
+          @param xonxoff modbus communication synchronous and asynchronous setting
+          @param timeout response timeout, in seconds
+        '''
+        self._serial = serial.Serial(port, baud, bytesize, parity, stopbit, xonxoff, timeout=0)
+        self._fd = self._serial.fileno()
+        self._timeout = timeout
+        # 3.5 characters of 11 bits, fixed to 1.75ms above 19200 baud by the Modbus RTU specification
+        self._gap = 3.5 * 11 / baud if baud <= 19200 else 0.00175
+        self._last = 0
+        self._lock = None
+
+    async def transact(self, request, min_len):
+        '''!
+          @brief Send a request frame and receive its response
+          @param request request frame without CRC
+          @param min_len length of the response header telling the full length(5 for 0x03 and 0x10)
+          @return bytearray: response frame with a valid CRC, empty on timeout, CRC error or exception response
+        '''
+        loop = asyncio.get_event_loop()
+        if self._lock is None:
+            # created on first use so that it belongs to the running loop
+            self._lock = asyncio.Lock()
+        request = bytearray(request)
+        crc = crc16(request)
+        request += bytearray([crc & 0xFF, crc >> 8])
+        async with self._lock:
+            wait = self._last + self._gap - loop.time()
+            if wait > 0:
+                await asyncio.sleep(wait)
+            self._serial.reset_input_buffer()
+            self._serial.write(request)
+            deadline = loop.time() + self._timeout
+            resp = await self._read(min_len, deadline)
+            if len(resp) == min_len and resp[0] == request[0]:
+                if resp[1] & 0x80:
+                    total = 5
+                elif 0x03 == resp[1]:
+                    total = 5 + resp[2]
+                else:
+                    total = 8
+                if total > min_len:
+                    resp += await self._read(total - min_len, deadline)
+            self._last = loop.time()
+        if len(resp) < 5 or resp[0] != request[0] or resp[1] != request[1] or 0 != crc16(resp):
+            logger.info("transaction failed: %s" % resp)
+            return bytearray()
+        return resp
+
+    async def _read(self, length, deadline):
+        loop = asyncio.get_event_loop()
+        buf = bytearray()
+        while len(buf) < length:
+            chunk = self._serial.read(length - len(buf))
+            if chunk:
+                buf += chunk
+                continue
+            remaining = deadline - loop.time()
+            if remaining <= 0:
+                break
+            readable = loop.create_future()
+            loop.add_reader(self._fd, lambda: readable.done() or readable.set_result(None))
+            try:
+                await asyncio.wait_for(readable, remaining)
+            except asyncio.TimeoutError:
+                pass
+            finally:
+                loop.remove_reader(self._fd)
+        return buf
+
+
+class DFRobot_RS01Async(DFRobot_RS01):
+    '''!
+      @brief asyncio variant of DFRobot_RS01
+      @details Same constants and parameter checks as DFRobot_RS01, every public method is a coroutine
+    '''
+
+    def __init__(self, addr, port="/dev/ttyAMA0", baud = 115200, bytesize = 8, parity = 'N', stopbit = 1, xonxoff=0,
+                 bus = None):
+        '''!
+          @brief Module RTU communication init
+          @param addr modbus communication address
+          @param port modbus communication serial port, ignored when bus is given
+          @param baud modbus communication baud rate, ignored when bus is given
+          @param bytesize modbus communication byte size, ignored when bus is given
+          @param parity modbus communication check bit, ignored when bus is given
+          @param stopbit modbus communication stop bit, ignored when bus is given
+          @param xonxoff modbus communication synchronous and asynchronous setting, ignored when bus is given
+          @param bus RS01AsyncBus shared with other sensors on the same port, None opens the port
+        '''
+        self._rs01_addr = addr
+        self._lock = None
+        if bus is None:
+            bus = RS01AsyncBus(port, baud, bytesize, parity, stopbit, xonxoff)
+        self._bus = bus
+
+    async def begin(self):
+        '''!
+          @brief Init sensor
+          @return  return initialization status
+          @retval True indicate initialization succeed
+          @retval False indicate initialization failed
+        '''
+        await asyncio.sleep(1)
+        if not (1 <= self._rs01_addr <= 0xF7):
+            return False
+        buf = await self._read_reg(RS01_PID_REG, 1)
+        return 0 != len(buf) and RS01_PID == buf[0]
+
+    async def read_basic_info(self):
+        '''!
+          @brief Read the device basic information, see DFRobot_RS01.read_basic_info()
+          @return list: empty when the read failed
+        '''
+        return await self._read_reg(RS01_PID_REG, 6)
+
+    async def read_measurement_data(self):
+        '''!
+          @brief Read the measured data from the module, see DFRobot_RS01.read_measurement_data()
+          @return list: empty when the read failed
+        '''
+        return await self._read_reg(RS01_TARGETS_NUMBER, 11)
+
+    async def read_measurement_config(self):
+        '''!
+          @brief read the module measurement parameters currently configured, see DFRobot_RS01.read_measurement_config()
+          @return list: empty when the read failed
+        '''
+        return await self._read_reg(MEASUREMENT_START_POSITION, 6)
+
+    async def set_ADDR(self, addr):
+        '''!
+          @brief Set the module communication address
+          @param addr Device address to be set, (1~247 is 0x0001~0x00F7)
+        '''
+        if 0x0001 < addr < 0x00F7:
+            if 0 != len(await self._write_reg(RS01_ADDR_REG, [addr])):
+                self._rs01_addr = addr
+            else:
+                logger.info("Set addr failed!")
+
+    async def set_baudrate_mode(self, mode):
+        '''!
+          @brief Set the module baud rate, power off to save the settings, and restart for the settings to take effect
+          @param mode The baud rate to be set, see DFRobot_RS01.set_baudrate_mode()
+        '''
+        if 0 != len(await self._write_reg(RS01_BAUDRATE_REG, [mode])):
+            await asyncio.sleep(0.5)
+        else:
+            logger.info("Set baudrate failed!")
+
+    async def set_checkbit_stopbit(self, mode):
+        '''!
+          @brief Set check bit and stop bit of the module
+          @param mode The mode to be set, see DFRobot_RS01.set_checkbit_stopbit()
+        '''
+        if 0 == len(await self._write_reg(RS01_CHECKBIT_STOPBIT_REG, [mode])):
+            logger.info("Set checkbit and stopbit failed!")
+
+    async def set_all_measurement_parameters(self, starting_position, stop_position,
+                                              initial_threshold, end_threshold,
+                                              module_sensitivity, comparison_offset):
+        '''!
+          @brief configure all measurement parameters, see DFRobot_RS01.set_all_measurement_parameters()
+          @param starting_position value at start position, 0x0046~0x19C8
+          @param stop_position value at stop position, 0x0046~0x19C8
+          @param initial_threshold initial threshold, 0x0064~0x2710
+          @param end_threshold end threshold, 0x0064~0x2710
+          @param module_sensitivity module sensitivity, 0x0000~0x0004
+          @param comparison_offset comparison offset, 0x0000~0xFFFF
+        '''
+        self.reg_value_buf = await self._read_reg(MEASUREMENT_START_POSITION, 6)
+        if 0 == len(self.reg_value_buf):
+            logger.info("read all measurement parameters failed!")
+        else:
+            if 0x0046 <= starting_position <= self.reg_value_buf[1]:
+                self.reg_value_buf[0] = starting_position
+            if self.reg_value_buf[0] <= stop_position <= 0x19C8:
+                self.reg_value_buf[1] = stop_position
+            if 0x0064 <= initial_threshold <= 0x2710 and 0 < initial_threshold + self.reg_value_buf[5]:
+                self.reg_value_buf[2] = initial_threshold
+            if 0x0064 <= end_threshold <= 0x2710 and 0 < end_threshold + self.reg_value_buf[5]:
+                self.reg_value_buf[3] = end_threshold
+            if 0x0000 <= module_sensitivity <= 0x0004:
+                self.reg_value_buf[4] = module_sensitivity
+            if (0 < self.reg_value_buf[2] + comparison_offset) and (0 < comparison_offset + self.reg_value_buf[3]):
+                self.reg_value_buf[5] = comparison_offset
+
+            if 0 == len(await self._write_reg(MEASUREMENT_START_POSITION, self.reg_value_buf)):
+                logger.info("set all measurement parameters failed!")
+            await asyncio.sleep(1)
+
+    async def restore_factory_setting(self):
+        '''!
+          @brief Restore to factory setting
+        '''
+        if 0 == len(await self._write_reg(RS01_RESET_FACTORY, 0x0000)):
+            logger.info("restore factory setting failed!")
+
+    async def _write_reg(self, reg, data):
+        '''!
+          @brief writes data to a register
+          @param reg register address
+                 data written data
+          @return Write register address, and write length, empty tuple when the write failed
+        '''
+        if isinstance(data, int):
+            data = [data]
+        request = bytearray([self._rs01_addr, 0x10, reg >> 8, reg & 0xFF, 0x00, len(data), 2 * len(data)])
+        for value in data:
+            request += bytearray([(value >> 8) & 0xFF, value & 0xFF])
+        resp = await self._bus.transact(request, 5)
+        if 8 != len(resp):
+            return ()
+        ret = ((resp[2] << 8) | resp[3], (resp[4] << 8) | resp[5])
+        logger.info(ret)
+        return ret
+
+    async def _read_reg(self, reg, length):
+        '''!
+          @brief read the data from the register
+          @param reg register address
+                 length read data length
+          @return list: The value list of the holding register, empty when the read failed
+        '''
+        request = bytearray([self._rs01_addr, 0x03, reg >> 8, reg & 0xFF, 0x00, length])
+        resp = await self._bus.transact(request, 5)
+        if 5 + 2 * length != len(resp):
+            return []
+        return [(resp[3 + 2 * i] << 8) | resp[4 + 2 * i] for i in range(length)]
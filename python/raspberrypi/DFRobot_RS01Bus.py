@@ -0,0 +1,195 @@
+# -*- coding: utf-8 -*
+'''!
+  @file  DFRobot_RS01Bus.py
+  @brief  Define the infrastructure of RS01Bus class
+  @details  Several RS01 sensors on one RS485 port: a dedicated thread polls the measurement
+  @n        block of every address over a single shared serial port and decodes the frames into a
+  @n        preallocated array, the latest values are read without taking the bus lock
+  @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+  @license  The MIT License (MIT)
+  @author  [qsjhyy](yihuan.huang@dfrobot.com)
+  @version  V1.0
+  @date  2021-07-23
+  @url  https://github.com/DFRobot/DFRobot_RS01
+'''
+import time
+import struct
+import threading
+import serial
+
+from modbus_tk import modbus_rtu
+
+from DFRobot_RS01 import *
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+import array
+
+## number of registers in the measurement block (targets number, then distance/intensity of 5 objects)
+RS01_BUS_BLOCK_LEN = 11
+## response length of the measurement block read: addr, function, byte count, 22 data bytes, CRC
+RS01_BUS_FRAME_LEN = 5 + 2 * RS01_BUS_BLOCK_LEN
+
+def _crc16_table():
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0xA001 if crc & 1 else crc >> 1
+        table.append(crc)
+    return table
+
+_CRC16_TABLE = _crc16_table()
+
+def crc16(data):
+    '''!
+      @brief Modbus CRC16 of a byte sequence, a complete frame including its CRC gives 0
+      @param data bytearray or bytes
+      @return CRC value
+    '''
+    crc = 0xFFFF
+    for c in bytearray(data):
+        crc = (crc >> 8) ^ _CRC16_TABLE[(crc ^ c) & 0xFF]
+    return crc
+
+class RS01Bus(object):
+    '''!
+      @brief RS01 sensors sharing one serial port, polled from a dedicated thread
+    '''
+
+    def __init__(self, port="/dev/ttyAMA0", baud = 115200, bytesize = 8, parity = 'N', stopbit = 1, xonxoff=0, timeout = 0.1):
+        '''!
+          @brief Open the shared serial port
+          @param port modbus communication serial port
+          @param baud modbus communication baud rate
+          @param bytesize modbus communication byte size
+          @param parity modbus communication check bit
+          @param stopbit modbus communication stop bit
+          @param xonxoff modbus communication synchronous and asynchronous setting
+          @param timeout response timeout of one sensor, in seconds
+        '''
+        self._serial = serial.Serial(port, baud, bytesize, parity, stopbit, xonxoff, timeout=timeout)
+        self._master = modbus_rtu.RtuMaster(self._serial)
+        self._master.set_timeout(timeout)
+        self._lock = threading.Lock()
+        self._addrs = []
+        self._requests = []
+        self._sensors = []
+        self._thread = None
+        self._running = False
+        self._period = 0
+        self._allocate(0)
+
+    def _allocate(self, count):
+        if numpy is not None:
+            self._data = numpy.zeros((count, RS01_BUS_BLOCK_LEN), dtype=numpy.uint16)
+        else:
+            self._data = [array.array('H', [0] * RS01_BUS_BLOCK_LEN) for _ in range(count)]
+        self._seq = [0] * count
+        self._stamp = [0.0] * count
+        self._errors = [0] * count
+        self._sweeps = 0
+
+    def add_sensor(self, addr):
+        '''!
+          @brief Add a sensor to the bus, only allowed while the poll thread is stopped
+          @param addr modbus communication address(1~247)
+          @return DFRobot_RS01 object sharing the bus port, for the configuration API; its index in
+          @n      latest()/snapshot() is the order of the add_sensor() calls
+        '''
+        if self._running:
+            raise RuntimeError("add_sensor() while the bus is running")
+        request = bytearray([addr, 0x03, RS01_TARGETS_NUMBER >> 8, RS01_TARGETS_NUMBER & 0xFF, 0x00, RS01_BUS_BLOCK_LEN])
+        crc = crc16(request)
+        request += bytearray([crc & 0xFF, crc >> 8])
+        sensor = DFRobot_RS01(addr, master=self._master, lock=self._lock)
+        self._addrs.append(addr)
+        self._requests.append(bytes(request))
+        self._sensors.append(sensor)
+        self._allocate(len(self._addrs))
+        return sensor
+
+    def start(self, period = 0):
+        '''!
+          @brief Start the poll thread
+          @param period minimum time between the starts of two sweeps over all sensors, in seconds, 0 polls back to back
+        '''
+        if self._running:
+            return
+        self._period = period
+        self._running = True
+        self._thread = threading.Thread(target=self._run)
+        self._thread.daemon = True
+        self._thread.start()
+
+    def stop(self):
+        '''!
+          @brief Stop the poll thread and wait for the sweep in progress to finish
+        '''
+        self._running = False
+        if self._thread is not None:
+            self._thread.join()
+            self._thread = None
+
+    def latest(self, index):
+        '''!
+          @brief Latest measurement of a sensor, without taking the bus lock
+          @param index sensor index(order of add_sensor())
+          @return tuple: (measurement list, time.time() of the read, error count)
+          @n      measurement list has the layout of DFRobot_RS01.read_measurement_data(), time is 0 before the first good read
+        '''
+        while True:
+            seq = self._seq[index]
+            if seq & 1:
+                continue
+            data = self._data[index].tolist()
+            stamp = self._stamp[index]
+            if seq == self._seq[index]:
+                return (data, stamp, self._errors[index])
+
+    def snapshot(self):
+        '''!
+          @brief Latest measurement of all sensors
+          @return list of latest() tuples, in add_sensor() order
+        '''
+        return [self.latest(i) for i in range(len(self._addrs))]
+
+    def get_sweep_count(self):
+        '''!
+          @brief Number of completed sweeps since the bus was started
+        '''
+        return self._sweeps
+
+    def _run(self):
+        while self._running:
+            begin = time.time()
+            for i in range(len(self._requests)):
+                if not self._running:
+                    break
+                self._poll_one(i)
+            self._sweeps += 1
+            wait = self._period - (time.time() - begin)
+            if wait > 0:
+                time.sleep(wait)
+
+    def _poll_one(self, index):
+        with self._lock:
+            self._serial.reset_input_buffer()
+            self._serial.write(self._requests[index])
+            resp = bytearray(self._serial.read(5))
+            if 5 == len(resp) and 0x03 == resp[1]:
+                resp += bytearray(self._serial.read(RS01_BUS_FRAME_LEN - 5))
+        # an exception answer(0x83) or a timeout ends with a short or a bad frame
+        if RS01_BUS_FRAME_LEN != len(resp) or resp[0] != self._addrs[index] or 0 != crc16(resp):
+            self._errors[index] += 1
+            logger.info("sensor 0x%02x read failed" % self._addrs[index])
+            return
+        self._seq[index] += 1
+        if numpy is not None:
+            self._data[index] = numpy.frombuffer(resp, dtype='>u2', count=RS01_BUS_BLOCK_LEN, offset=3)
+        else:
+            self._data[index] = array.array('H', struct.unpack_from('>%dH' % RS01_BUS_BLOCK_LEN, bytes(resp), 3))
+        self._stamp[index] = time.time()
+        self._seq[index] += 1
@@ -0,0 +1,53 @@
+# -*- coding: utf-8 -*
+'''!
+  @file async_read.py
+  @brief Read several sensors on one RS485 port from an asyncio event loop(python3.5 or later)
+  @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+  @license  The MIT License (MIT)
+  @author  [qsjhyy](yihuan.huang@dfrobot.com)
+  @version  V1.0
+  @date  2021-07-23
+  @url  https://github.com/DFRobot/DFRobot_RS01
+'''
+import sys
+import os
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.realpath(__file__)))))
+
+from DFRobot_RS01Async import *
+
+# Every sensor on the bus needs a different communication address, see set_module_info.py
+ADDRS = (0x000E, 0x000F)
+
+async def setup(sensors):
+  for sensor in sensors:
+    while (await sensor.begin() == False):
+      print ('Please check that the device is properly connected')
+      await asyncio.sleep(3)
+  print("sensor begin successfully!!!")
+
+
+async def loop(sensors):
+  '''
+    The reads are gathered: the bus sends them one after the other with the RTU frame gap,
+    and the event loop stays free for other tasks while waiting for the answers
+  '''
+  results = await asyncio.gather(*[sensor.read_measurement_data() for sensor in sensors])
+  for addr, buf_data in zip(ADDRS, results):
+    if 0 != len(buf_data):
+      print("sensor 0x%02x: target amount: %d, nearest distance: %d, intensity: %d"
+            %(addr, buf_data[0], buf_data[1], buf_data[2]))
+    else:
+      print("sensor 0x%02x: Failed to read measurement data!!!" %addr)
+  print()
+
+  await asyncio.sleep(1)
+
+async def main():
+  bus = RS01AsyncBus(port = "/dev/ttyAMA0", baud = 115200)
+  sensors = [DFRobot_RS01Async(addr, bus = bus) for addr in ADDRS]
+  await setup(sensors)
+  while True:
+    await loop(sensors)
+
+if __name__ == "__main__":
+  asyncio.get_event_loop().run_until_complete(main())
@@ -0,0 +1,57 @@
+# -*- coding: utf-8 -*
+'''!
+  @file multi_sensor_bus.py
+  @brief Read several sensors on one RS485 port from a background poll thread
+  @copyright  Copyright (c) 2010 DFRobot Co.Ltd (http://www.dfrobot.com)
+  @license  The MIT License (MIT)
+  @author  [qsjhyy](yihuan.huang@dfrobot.com)
+  @version  V1.0
+  @date  2021-07-23
+  @url  https://github.com/DFRobot/DFRobot_RS01
+'''
+from __future__ import print_function
+import sys
+import os
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.realpath(__file__)))))
+
+from DFRobot_RS01Bus import *
+
+bus = RS01Bus(port = "/dev/ttyAMA0", baud = 115200)
+# Every sensor on the bus needs a different communication address, see set_module_info.py
+sensors = [bus.add_sensor(addr) for addr in (0x000E, 0x000F)]
+
+def setup():
+  for sensor in sensors:
+    while (sensor.begin() == False):
+      print ('Please check that the device is properly connected')
+      time.sleep(3)
+  print("sensor begin successfully!!!")
+
+  # Poll all sensors every 100ms
+  bus.start(period = 0.1)
+
+
+def loop():
+  '''
+    latest() returns the last values decoded by the poll thread, without waiting for the bus
+      The first element: measurement list, same layout as read_measurement_data()
+      The second element: time.time() of the read, 0 before the first good read
+      The third element: number of failed reads
+  '''
+  for i, (data, stamp, errors) in enumerate(bus.snapshot()):
+    if 0 == stamp:
+      print("sensor %d: no data yet, errors: %d" %(i, errors))
+      continue
+    print("sensor %d: targets: %d, nearest: %d, age: %.3fs, errors: %d"
+          %(i, data[0], data[1], time.time() - stamp, errors))
+  print()
+
+  time.sleep(1)
+
+if __name__ == "__main__":
+  setup()
+  try:
+    while True:
+      loop()
+  except KeyboardInterrupt:
+    bus.stop()